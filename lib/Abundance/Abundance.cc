@@ -11,11 +11,18 @@
 
 #include "Abundance.hh"
 
-Abundance::Abundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths) {
+Abundance::Abundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths) : budgetExhausted(false) {
 	this->graph = graph;
 	this->paths = paths;
 }
 
+Abundance::Abundance(boost::shared_ptr<HeftyGraph> graph, boost::shared_ptr<SkinnyGraph> subGraph,
+		     boost::unordered_set<PathBuilder::Path> graphPaths) : budgetExhausted(false) {
+	this->graph = graph;
+	this->subGraph = subGraph;
+	this->graphPaths = graphPaths;
+}
+
 boost::shared_ptr<HeftyGraph>
 Abundance::getGraph() {
 	return this->graph;
@@ -36,4 +43,41 @@ Abundance::setPaths(boost::unordered_set<std::string> paths) {
 	this->paths = paths;
 }
 
+boost::shared_ptr<SkinnyGraph>
+Abundance::getSubGraph() {
+	return this->subGraph;
+}
+
+boost::unordered_set<PathBuilder::Path>
+Abundance::getGraphPaths() {
+	return this->graphPaths;
+}
+
+void
+Abundance::setGraphPaths(boost::shared_ptr<SkinnyGraph> subGraph, boost::unordered_set<PathBuilder::Path> graphPaths) {
+	this->subGraph = subGraph;
+	this->graphPaths = graphPaths;
+}
+
+void
+Abundance::setBudget(boost::shared_ptr<Budget> budget) {
+	this->budget = budget;
+	this->budgetExhausted = false;
+}
+
+bool
+Abundance::truncated() {
+	return this->budgetExhausted;
+}
+
+bool
+Abundance::withinBudget() {
+	if (this->budget && this->budget->expired()) {
+		this->budgetExhausted = true;
+		return false;
+	}
+
+	return true;
+}
+
 #endif // ABUNDANCE_CC
@@ -8,10 +8,13 @@
 #define ABUNDANCE_HH
 
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "Graph/HeftyGraph.hh"
 #include "Graph/Node/SequenceNode.hh"
+#include "PathBuilder/PathBuilder.hh"
+#include "Util/Budget.hh"
 
 class Abundance {
 public:
@@ -23,19 +26,55 @@ public:
 	boost::unordered_set<std::string> getPaths();
 	/** set the paths that this abundance computer is computing abundances for */
 	void setPaths(boost::unordered_set<std::string> paths);
+	/** get the sub-graph that the graph paths were constructed from */
+	boost::shared_ptr<SkinnyGraph> getSubGraph();
+	/** get the graph paths that this abundance computer is computing abundances for */
+	boost::unordered_set<PathBuilder::Path> getGraphPaths();
+	/** set the sub-graph and the graph paths (constructed from that sub-graph) to compute abundances for */
+	void setGraphPaths(boost::shared_ptr<SkinnyGraph> subGraph, boost::unordered_set<PathBuilder::Path> graphPaths);
+	/** limit the time spent by the next call to computeAbundances or computePathAbundances */
+	void setBudget(boost::shared_ptr<Budget> budget);
+	/** did the most recent computation stop early (leaving some paths without an abundance)? */
+	bool truncated();
 
 	/** 
 	 * Compute abundances for the paths provided.
 	 */
 	virtual boost::unordered_map<std::string, double> computeAbundances() = 0;
+
+	/**
+	 * Compute abundances for the graph paths provided. Graph paths already describe the
+	 * vertices that they pass through, so they don't need to be re-hashed.
+	 */
+	virtual boost::unordered_map<PathBuilder::Path, double> computePathAbundances() = 0;
 protected:
 	/** Default constructor. */
 	Abundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths);
+	/** Constructor for paths that were constructed by a path builder. */
+	Abundance(boost::shared_ptr<HeftyGraph> graph, boost::shared_ptr<SkinnyGraph> subGraph, 
+		  boost::unordered_set<PathBuilder::Path> graphPaths);
 
 	/** the graph that we'll search for paths in */
 	boost::shared_ptr<HeftyGraph> graph;
 	/** the paths that we're computing abundances for */
 	boost::unordered_set<std::string> paths;
+	/** the sub-graph that the graph paths were constructed from */
+	boost::shared_ptr<SkinnyGraph> subGraph;
+	/** the graph paths that we're computing abundances for */
+	boost::unordered_set<PathBuilder::Path> graphPaths;
+
+	/**
+	 * Check whether the budget allows more abundances to be computed. Implementations should
+	 * check before each path, and only report abundances for the paths already computed when
+	 * the budget runs out.
+	 * @return false (and mark the abundances as truncated) if the budget has run out.
+	 */
+	bool withinBudget();
+private:
+	/** the limit on time spent (no limit if null) */
+	boost::shared_ptr<Budget> budget;
+	/** did computing abundances stop early because the budget ran out? */
+	bool budgetExhausted;
 };
 
 #endif // ABUNDANCE_HH
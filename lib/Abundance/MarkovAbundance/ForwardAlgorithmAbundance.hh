@@ -21,10 +21,20 @@ public:
 	ForwardAlgorithmAbundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths);
 
 	/**
-	 * Compute abundances for the paths supplied.
-	 * @return a set of sequences and their relative abundance in the graph
+	 * Constructor.
+	 * @param graph the graph that the sub-graph belongs to
+	 * @param subGraph the sub-graph that the paths were constructed from
+	 * @param graphPaths the paths to compute abundances for
+	 */
+	ForwardAlgorithmAbundance(boost::shared_ptr<HeftyGraph> graph, boost::shared_ptr<SkinnyGraph> subGraph,
+				  boost::unordered_set<PathBuilder::Path> graphPaths);
+protected:
+	/**
+	 * The forward recursion starts in the first vertex of a path with probability 1.
+	 * @param table the transition table for the sub-graph.
+	 * @return the log probability of starting at each vertex (by dense vertex identifier).
 	 */
-	boost::unordered_map<std::string, double> computeAbundances();
+	std::vector<double> initialProbabilities(boost::shared_ptr<TransitionTable> table);
 };
 
 #endif // FORWARD_ALGORITHM_ABUNDANCE_HH
@@ -8,35 +8,153 @@
 #define MARKOV_ABUNDANCE_CC
 
 #include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
+#include <map>
 
 #include "MarkovAbundance.hh"
+#include "Exception/InvalidGraphStateException.hh"
 
 DECLARE_LOG(logger, "qassembler.MarkovAbundance");
 
-MarkovAbundance::MarkovAbundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths) : Abundance(graph, paths) {
-	this->beginStateTransitionSum = computeBeginStateTransitionSum();
+MarkovAbundance::MarkovAbundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths) : Abundance(graph, paths) {}
+
+MarkovAbundance::MarkovAbundance(boost::shared_ptr<HeftyGraph> graph, boost::shared_ptr<SkinnyGraph> subGraph,
+				 boost::unordered_set<PathBuilder::Path> graphPaths) : Abundance(graph, subGraph, graphPaths) {}
+
+boost::unordered_map<std::string, double>
+MarkovAbundance::computeAbundances() {
+	boost::unordered_map<std::string, double> records;
+	// sequences may come from any sub-graph, so group them by the sub-graph that they pass through.
+	std::map<std::size_t, boost::shared_ptr<SkinnyGraph> > subGraphs;
+	std::map<std::size_t, std::vector<std::string> > sequences;
+	std::map<std::size_t, std::vector<VertexPath> > batches;
+
+	BOOST_FOREACH (std::string path, paths) {
+		TRACE(logger, "Working on path [" << path << "]");
+		boost::shared_ptr<SkinnyGraph> g;
+		VertexPath vertices = sequenceToVertices(path, g);
+		subGraphs[g->getId()] = g;
+		sequences[g->getId()].push_back(path);
+		batches[g->getId()].push_back(vertices);
+	}
+
+	typedef std::pair<std::size_t, boost::shared_ptr<SkinnyGraph> > SubGraph;
+	BOOST_FOREACH (SubGraph sg, subGraphs) {
+		std::vector<double> abundances = computeBatchAbundances(sg.second, batches[sg.first]);
+		for (std::size_t i = 0; i < abundances.size(); i++) {
+			records[sequences[sg.first][i]] = abundances[i];
+			DEBUG(logger, "Final abundance for path [" << sequences[sg.first][i] << "] is [" << abundances[i] << "]");
+		}
+	}
+
+	return records;
+}
+
+boost::unordered_map<PathBuilder::Path, double>
+MarkovAbundance::computePathAbundances() {
+	boost::unordered_map<PathBuilder::Path, double> records;
+	std::vector<PathBuilder::Path> ordered;
+	std::vector<VertexPath> batch;
+
+	ordered.reserve(graphPaths.size());
+	batch.reserve(graphPaths.size());
+	BOOST_FOREACH (PathBuilder::Path path, graphPaths) {
+		ordered.push_back(path);
+		batch.push_back(pathToVertices(path, subGraph));
+	}
+
+	std::vector<double> abundances = computeBatchAbundances(subGraph, batch);
+	for (std::size_t i = 0; i < abundances.size(); i++) {
+		records[ordered[i]] = abundances[i];
+		DEBUG(logger, "Final abundance for path with [" << ordered[i].size() << "] vertices is [" << abundances[i] << "]");
+	}
+
+	return records;
+}
+
+std::vector<double>
+MarkovAbundance::computeBatchAbundances(boost::shared_ptr<SkinnyGraph> g, const std::vector<VertexPath> &batch) {
+	boost::shared_ptr<TransitionTable> table = getTransitionTable(g);
+	PathTrie trie(table);
+	std::vector<std::size_t> ends;
+	std::vector<double> abundances;
+
+	ends.reserve(batch.size());
+	BOOST_FOREACH (const VertexPath &vertices, batch) {
+		if (!withinBudget()) {
+			DEBUG(logger, "Budget for graph [" << g->getId() << "] ran out after [" << ends.size() << "] of [" << batch.size() << "] paths.");
+			break;
+		}
+		ends.push_back(trie.insert(vertices));
+	}
+	DEBUG(logger, "Evaluating [" << trie.numNodes() << "] trie nodes for [" << trie.numInsertedVertices() << "] path vertices in graph [" << g->getId() << "].");
+
+	std::vector<double> scores = trie.evaluate(initialProbabilities(table));
+	abundances.reserve(batch.size());
+	BOOST_FOREACH (std::size_t end, ends) {
+		abundances.push_back(scores[end]);
+	}
+
+	return abundances;
 }
 
 std::size_t
 MarkovAbundance::getBeginStateTransitionSum() {
-	return this->beginStateTransitionSum;
+	// the sum is cached by the graph so that all estimators (one per sub-graph) can share it.
+	return this->graph->getBeginStateTransitionSum();
 }
 
-std::size_t
-MarkovAbundance::computeBeginStateTransitionSum() {
-	std::size_t transitionSum = 0;
-
-	BOOST_FOREACH (boost::shared_ptr<SkinnyGraph> g, this->graph->getGraphs()) {
-		BOOST_FOREACH (SkinnyGraph::Vertex v, g->getVertexIterators()) {
-			if (boost::in_degree (v, *g->graph()) == 0) {
-				boost::shared_ptr<SequenceNode> node = g->node(v);
-				boost::shared_ptr<Kmer> firstMer = node->getKmer(0);
-				transitionSum += firstMer->getCount();
-			}
+boost::shared_ptr<TransitionTable>
+MarkovAbundance::getTransitionTable(boost::shared_ptr<SkinnyGraph> g) {
+	boost::shared_ptr<TransitionTable> table = this->transitionTables[g->getId()];
+
+	if (!table) {
+		table = boost::make_shared<TransitionTable>(g, getBeginStateTransitionSum());
+		this->transitionTables[g->getId()] = table;
+	}
+
+	return table;
+}
+
+MarkovAbundance::VertexPath
+MarkovAbundance::sequenceToVertices(std::string sequence, boost::shared_ptr<SkinnyGraph> &g) {
+	VertexPath vertices;
+	uint16_t kmerLength = graph->getKmerLength();
+	std::string kmer = sequence.substr(0, kmerLength);
+	boost::shared_ptr<SkinnyGraph> kmerGraph; SkinnyGraph::Vertex kmerVertex;
+
+	boost::tie(g, kmerVertex) = graph->getGraphAndVertexForHash(qassembler::hash(kmer));
+	vertices.push_back(kmerVertex);
+
+	for (std::size_t i = kmerLength; i < sequence.size(); i++) {
+		kmer.erase(0, 1);
+		kmer.push_back(sequence[i]);
+		boost::tie(kmerGraph, kmerVertex) = graph->getGraphAndVertexForHash(qassembler::hash(kmer));
+
+		if (kmerGraph->getId() != g->getId()) {
+			throw InvalidGraphStateException("A path can be generated from only one graph.");
 		}
+
+		// consecutive k-mers in the same vertex don't add a transition.
+		if (kmerVertex != vertices.back()) {
+			vertices.push_back(kmerVertex);
+		}
+	}
+
+	return vertices;
+}
+
+MarkovAbundance::VertexPath
+MarkovAbundance::pathToVertices(PathBuilder::Path path, boost::shared_ptr<SkinnyGraph> g) {
+	VertexPath vertices;
+
+	vertices.reserve(path.size());
+	BOOST_FOREACH (boost::shared_ptr<SequenceNode> node, path) {
+		// every k-mer in a node maps to the node's vertex, so we only need to look up the first.
+		vertices.push_back(g->getVertexForHash(node->getKmer(0)->getHash()));
 	}
 
-	return transitionSum;
+	return vertices;
 }
 
 #endif // MARKOV_ABUNDANCE_CC
@@ -8,15 +8,25 @@
 #define MARKOV_ABUNDANCE_HH
 
 #include "Abundance/Abundance.hh"
+#include "Abundance/MarkovAbundance/TransitionTable.hh"
+#include "Abundance/MarkovAbundance/PathTrie.hh"
 
 #include "Logging/Logging.hh"
 
 class MarkovAbundance : public Abundance {
 public:
+	/** an ordered list of vertices in a single sub-graph */
+	typedef std::vector<SkinnyGraph::Vertex> VertexPath;
+
 	/**
 	 * Compute abundances for the paths provided.
 	 */
-	virtual boost::unordered_map<std::string, double> computeAbundances() = 0;
+	boost::unordered_map<std::string, double> computeAbundances();
+
+	/**
+	 * Compute abundances for the graph paths provided.
+	 */
+	boost::unordered_map<PathBuilder::Path, double> computePathAbundances();
 protected:
 	/**
 	 * Constructor.
@@ -25,22 +35,68 @@ protected:
 	 */
 	MarkovAbundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths);
 
+	/**
+	 * Constructor.
+	 * @param graph the graph that the sub-graph belongs to
+	 * @param subGraph the sub-graph that the paths were constructed from
+	 * @param graphPaths the paths to compute abundances for
+	 */
+	MarkovAbundance(boost::shared_ptr<HeftyGraph> graph, boost::shared_ptr<SkinnyGraph> subGraph,
+			boost::unordered_set<PathBuilder::Path> graphPaths);
+
+	/**
+	 * Compute the abundances for a batch of paths through the same sub-graph. Paths are inserted
+	 * into a prefix trie so that the probability of a prefix shared by several paths is only computed
+	 * once, then the probability at the end of each path is reported.
+	 * @param g the sub-graph that the paths pass through
+	 * @param batch the ordered lists of vertices that each path visits
+	 * @return the abundance of each path (in the same order as batch). If the budget runs out,
+	 * only the abundances of the first paths in the batch are reported.
+	 */
+	std::vector<double> computeBatchAbundances(boost::shared_ptr<SkinnyGraph> g, const std::vector<VertexPath> &batch);
+
+	/**
+	 * Get the (log) probability of a path starting at each vertex in a sub-graph.
+	 * @param table the transition table for the sub-graph.
+	 * @return the log probability of starting at each vertex (by dense vertex identifier).
+	 */
+	virtual std::vector<double> initialProbabilities(boost::shared_ptr<TransitionTable> table) = 0;
+
 	/**
 	 * Get the sum of the edges that transition from the 'start' state to a state that
 	 * emits symbols. The total edge weight is computed by determining total number of instances
-	 * of the first kmer in the vertices which have no incoming edges.
+	 * of the first kmer in the vertices which have no incoming edges, and is cached by the graph.
 	 * @return the total sum of 'edge weights' that have vertices that have no incoming edges.
 	 */
 	std::size_t getBeginStateTransitionSum();
 
+	/**
+	 * Get the transition table for a sub-graph. The table is built the first time that it is
+	 * requested and shared by all paths through that sub-graph.
+	 * @param g the sub-graph to get the transition table for.
+	 * @return the transition table for g.
+	 */
+	boost::shared_ptr<TransitionTable> getTransitionTable(boost::shared_ptr<SkinnyGraph> g);
 private:
-	std::size_t beginStateTransitionSum;
+	/** transition tables for sub-graphs, by sub-graph identifier */
+	boost::unordered_map<std::size_t, boost::shared_ptr<TransitionTable> > transitionTables;
+
+	/**
+	 * Find the vertices that a sequence passes through by hashing each of the k-mers in
+	 * the sequence.
+	 * @param sequence the sequence to find vertices for.
+	 * @param g set to the sub-graph that the sequence passes through.
+	 * @return the ordered list of vertices that the sequence passes through.
+	 */
+	VertexPath sequenceToVertices(std::string sequence, boost::shared_ptr<SkinnyGraph> &g);
 
 	/**
-	 * Compute the total sum of transitions from the start state to a state in the model.
-	 * @return the toal sum of edges.
+	 * Find the vertices for the sequence nodes in a path constructed by a path builder.
+	 * @param path the path to find vertices for.
+	 * @param g the sub-graph that the path was constructed from.
+	 * @return the ordered list of vertices that the path passes through.
 	 */
-	std::size_t computeBeginStateTransitionSum();
+	VertexPath pathToVertices(PathBuilder::Path path, boost::shared_ptr<SkinnyGraph> g);
 };
 
 #endif // MARKOV_ABUNDANCE_HH
@@ -21,25 +21,21 @@ public:
 	MarkovChainAbundance(boost::shared_ptr<HeftyGraph> graph, boost::unordered_set<std::string> paths);
 
 	/**
-	 * Compute abundances for the paths supplied.
-	 * @return a set of sequences and their relative abundance in the graph
-	 */
-	boost::unordered_map<std::string, double> computeAbundances();
-private:
-	/**
-	 * Compute the sum of the weights of the edges outgoing from the specified vertex.
-	 * @param v the vertex to compute the sum for.
-	 * @param g the graph in which v can be found.
-	 * @return the sum of edge weights exiting v.
+	 * Constructor.
+	 * @param graph the graph that the sub-graph belongs to
+	 * @param subGraph the sub-graph that the paths were constructed from
+	 * @param graphPaths the paths to compute abundances for
 	 */
-	double sumOutgoingEdges(SkinnyGraph::Vertex v, boost::shared_ptr<SkinnyGraph> g);
+	MarkovChainAbundance(boost::shared_ptr<HeftyGraph> graph, boost::shared_ptr<SkinnyGraph> subGraph,
+			     boost::unordered_set<PathBuilder::Path> graphPaths);
+protected:
 	/**
-	 * Compute the sum of the weights of the edges incoming to the specified vertex.
-	 * @param v the vertex to compute the sum for.
-	 * @param g the graph in which v can be found.
-	 * @return the sum of edge weights entering v.
+	 * The (log) probability of a path starting at a vertex is the probability of transitioning
+	 * from the 'start' state to that vertex.
+	 * @param table the transition table for the sub-graph.
+	 * @return the log probability of starting at each vertex (by dense vertex identifier).
 	 */
-	double sumIncomingEdges(SkinnyGraph::Vertex v, boost::shared_ptr<SkinnyGraph> g);
+	std::vector<double> initialProbabilities(boost::shared_ptr<TransitionTable> table);
 };
 
 #endif // MARKOV_CHAIN_ABUNDANCE_HH
@@ -0,0 +1,92 @@
+/*
+ * File:   PathTrie.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef PATH_TRIE_CC
+#define PATH_TRIE_CC
+
+// sentinel used for missing nodes.
+#define NO_NODE ((std::size_t) -1)
+
+#include "PathTrie.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+PathTrie::PathTrie(boost::shared_ptr<TransitionTable> table) {
+	this->table = table;
+	this->firstRoot = NO_NODE;
+	this->insertedVertices = 0;
+}
+
+std::size_t
+PathTrie::insert(const std::vector<SkinnyGraph::Vertex> &vertices) {
+	if (vertices.empty()) {
+		throw InvalidGraphStateException("Cannot insert an empty path.");
+	}
+
+	std::size_t node = findOrCreateChild(NO_NODE, vertices[0], vertices[0]);
+	for (std::size_t i = 1; i < vertices.size(); i++) {
+		node = findOrCreateChild(node, vertices[i - 1], vertices[i]);
+	}
+	insertedVertices += vertices.size();
+
+	return node;
+}
+
+std::size_t
+PathTrie::findOrCreateChild(std::size_t parentNode, SkinnyGraph::Vertex source, SkinnyGraph::Vertex target) {
+	std::size_t targetIndex = table->vertexIndex(target);
+	std::size_t child = (parentNode == NO_NODE) ? firstRoot : firstChild[parentNode];
+
+	for (; child != NO_NODE; child = nextSibling[child]) {
+		if (vertex[child] == targetIndex) {
+			return child;
+		}
+	}
+
+	// nodes are only ever appended, so a parent always comes before its children.
+	child = vertex.size();
+	vertex.push_back(targetIndex);
+	firstChild.push_back(NO_NODE);
+	if (parentNode == NO_NODE) {
+		parent.push_back(child);
+		edge.push_back(NO_NODE);
+		nextSibling.push_back(firstRoot);
+		firstRoot = child;
+	} else {
+		parent.push_back(parentNode);
+		edge.push_back(table->edgeIndex(source, target));
+		nextSibling.push_back(firstChild[parentNode]);
+		firstChild[parentNode] = child;
+	}
+
+	return child;
+}
+
+std::vector<double>
+PathTrie::evaluate(const std::vector<double> &initial) {
+	std::vector<double> scores(vertex.size(), 0.);
+
+	for (std::size_t node = 0; node < vertex.size(); node++) {
+		if (parent[node] == node) {
+			scores[node] = initial[vertex[node]];
+		} else {
+			scores[node] = scores[parent[node]] + table->logTransition(edge[node]);
+		}
+	}
+
+	return scores;
+}
+
+std::size_t
+PathTrie::numNodes() {
+	return this->vertex.size();
+}
+
+std::size_t
+PathTrie::numInsertedVertices() {
+	return this->insertedVertices;
+}
+
+#endif // PATH_TRIE_CC
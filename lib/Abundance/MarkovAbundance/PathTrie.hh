@@ -0,0 +1,72 @@
+/*
+ * File:   PathTrie.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef PATH_TRIE_HH
+#define PATH_TRIE_HH
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+#include "Abundance/MarkovAbundance/TransitionTable.hh"
+
+class PathTrie {
+public:
+	/**
+	 * Constructor.
+	 * @param table the transition table for the sub-graph that paths will pass through.
+	 */
+	PathTrie(boost::shared_ptr<TransitionTable> table);
+
+	/**
+	 * Add a path to the trie. Paths that share a prefix share the trie nodes for that prefix.
+	 * @param vertices the ordered list of vertices that the path visits.
+	 * @return the trie node where the path ends.
+	 */
+	std::size_t insert(const std::vector<SkinnyGraph::Vertex> &vertices);
+
+	/**
+	 * Compute the (log) score of every trie node. The score of a node is the score of its parent
+	 * plus the log probability of the transition between the two vertices, so each shared prefix is
+	 * scored exactly once.
+	 * @param initial the log score of starting a path at each vertex (by dense vertex identifier).
+	 * @return the score of each trie node (by trie node identifier).
+	 */
+	std::vector<double> evaluate(const std::vector<double> &initial);
+
+	/** how many trie nodes are there? */
+	std::size_t numNodes();
+	/** how many vertices (in total) were inserted? */
+	std::size_t numInsertedVertices();
+private:
+	/** the transition table for the sub-graph */
+	boost::shared_ptr<TransitionTable> table;
+	/** the dense identifier of the vertex for each node */
+	std::vector<std::size_t> vertex;
+	/** the parent of each node (roots are their own parent) */
+	std::vector<std::size_t> parent;
+	/** the transition table edge from the parent to each node (unused for roots) */
+	std::vector<std::size_t> edge;
+	/** the first child of each node */
+	std::vector<std::size_t> firstChild;
+	/** the next sibling of each node */
+	std::vector<std::size_t> nextSibling;
+	/** the first root of the trie */
+	std::size_t firstRoot;
+	/** the total number of vertices inserted into the trie */
+	std::size_t insertedVertices;
+
+	/**
+	 * Find the child of a node (or root, if parent is NO_NODE) for a vertex, creating it if necessary.
+	 * @param parentNode the node to find the child of.
+	 * @param source the vertex at parentNode.
+	 * @param target the vertex to find a child for.
+	 * @return the child node.
+	 */
+	std::size_t findOrCreateChild(std::size_t parentNode, SkinnyGraph::Vertex source, SkinnyGraph::Vertex target);
+};
+
+#endif // PATH_TRIE_HH
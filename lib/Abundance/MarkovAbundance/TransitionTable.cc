@@ -0,0 +1,88 @@
+/*
+ * File:   TransitionTable.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef TRANSITION_TABLE_CC
+#define TRANSITION_TABLE_CC
+
+#include <boost/foreach.hpp>
+#include <cmath>
+
+#include "TransitionTable.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+DECLARE_LOG(logger, "qassembler.TransitionTable");
+
+TransitionTable::TransitionTable(boost::shared_ptr<SkinnyGraph> g, std::size_t beginStateTransitionSum) {
+	boost::shared_ptr<SkinnyGraph::Graph> graph = g->graph();
+	double logBeginSum = log(beginStateTransitionSum);
+
+	TRACE(logger, "Building transition table for graph [" << g->getId() << "].");
+	BOOST_FOREACH (SkinnyGraph::Vertex v, g->getVertexIterators()) {
+		std::size_t index = vertices.size();
+		vertices[v] = index;
+	}
+
+	edgeOffsets.reserve(vertices.size() + 1);
+	beginLogProbabilities.reserve(vertices.size());
+	edgeTargets.reserve(g->numEdges());
+	edgeLogProbabilities.reserve(g->numEdges());
+	BOOST_FOREACH (SkinnyGraph::Vertex v, g->getVertexIterators()) {
+		double outgoingWeight = 0;
+		BOOST_FOREACH (SkinnyGraph::Edge e, boost::out_edges(v, *graph)) {
+			outgoingWeight += g->edge(e)->getWeight();
+		}
+		double logOutgoing = log(outgoingWeight);
+
+		edgeOffsets.push_back(edgeTargets.size());
+		BOOST_FOREACH (SkinnyGraph::Edge e, boost::out_edges(v, *graph)) {
+			double weight = g->edge(e)->getWeight();
+			edgeTargets.push_back(vertices[boost::target(e, *graph)]);
+			edgeLogProbabilities.push_back(log(weight) - logOutgoing);
+		}
+
+		// the probability of transitioning from the 'start' state to a vertex is the number of
+		// instances of the first kmer in the vertex compared to the sum of all instances of first kmers.
+		beginLogProbabilities.push_back(log(g->node(v)->getKmer(0)->getCount()) - logBeginSum);
+	}
+	edgeOffsets.push_back(edgeTargets.size());
+}
+
+std::size_t
+TransitionTable::vertexIndex(SkinnyGraph::Vertex v) {
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t>::iterator index = vertices.find(v);
+
+	if (index == vertices.end()) {
+		throw InvalidGraphStateException("A path can be generated from only one graph.");
+	}
+
+	return index->second;
+}
+
+std::size_t
+TransitionTable::edgeIndex(SkinnyGraph::Vertex source, SkinnyGraph::Vertex target) {
+	std::size_t s = vertexIndex(source);
+	std::size_t t = vertexIndex(target);
+
+	for (std::size_t e = edgeOffsets[s]; e < edgeOffsets[s + 1]; e++) {
+		if (edgeTargets[e] == t) {
+			return e;
+		}
+	}
+
+	throw InvalidGraphStateException("A path can only follow edges that exist in the graph.");
+}
+
+std::size_t
+TransitionTable::numVertices() {
+	return this->vertices.size();
+}
+
+std::size_t
+TransitionTable::numEdges() {
+	return this->edgeTargets.size();
+}
+
+#endif // TRANSITION_TABLE_CC
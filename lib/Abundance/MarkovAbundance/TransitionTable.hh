@@ -0,0 +1,74 @@
+/*
+ * File:   TransitionTable.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef TRANSITION_TABLE_HH
+#define TRANSITION_TABLE_HH
+
+#include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+#include "Graph/SkinnyGraph.hh"
+
+class TransitionTable {
+public:
+	/**
+	 * Constructor. Computes the log transition probabilities for the current edge weights of
+	 * the sub-graph, so it should be constructed after edge weights are reset.
+	 * @param g the sub-graph to compute transition probabilities for.
+	 * @param beginStateTransitionSum the total weight of transitions from the 'start' state.
+	 */
+	TransitionTable(boost::shared_ptr<SkinnyGraph> g, std::size_t beginStateTransitionSum);
+
+	/**
+	 * Get the dense identifier for a vertex.
+	 * @param v the vertex in question.
+	 * @return the dense identifier for v.
+	 */
+	std::size_t vertexIndex(SkinnyGraph::Vertex v);
+
+	/**
+	 * Get the identifier of the edge between two vertices.
+	 * @param source the source of the edge.
+	 * @param target the target of the edge.
+	 * @return the dense identifier of the edge.
+	 */
+	std::size_t edgeIndex(SkinnyGraph::Vertex source, SkinnyGraph::Vertex target);
+
+	/**
+	 * Get the log probability of following an edge (the edge weight compared to the total
+	 * weight of all edges leaving the source of the edge).
+	 * @param edge the dense identifier of the edge.
+	 * @return the log probability of following the edge.
+	 */
+	double logTransition(std::size_t edge) { return edgeLogProbabilities[edge]; }
+
+	/**
+	 * Get the log probability of transitioning from the 'start' state to a vertex.
+	 * @param vertex the dense identifier of the vertex.
+	 * @return the log probability of starting a path at the vertex.
+	 */
+	double logBegin(std::size_t vertex) { return beginLogProbabilities[vertex]; }
+
+	/** how many vertices are in this table? */
+	std::size_t numVertices();
+	/** how many edges are in this table? */
+	std::size_t numEdges();
+private:
+	/** dense identifiers for the vertices in the sub-graph */
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t> vertices;
+	/** the position of the first outgoing edge of each vertex in edgeTargets (one extra entry at the end) */
+	std::vector<std::size_t> edgeOffsets;
+	/** the dense identifier of the target of each edge, grouped by source vertex */
+	std::vector<std::size_t> edgeTargets;
+	/** the log probability of following each edge, grouped by source vertex */
+	std::vector<double> edgeLogProbabilities;
+	/** the log probability of starting a path at each vertex */
+	std::vector<double> beginLogProbabilities;
+};
+
+#endif // TRANSITION_TABLE_HH
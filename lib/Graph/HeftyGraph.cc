@@ -13,6 +13,7 @@
 
 
 #include <list>
+#include <cmath>
 #include "Graph/HeftyGraph.hh"
 #include "Util/Util.hh"
 #include "Exception/ReadSizeException.hh"
@@ -22,18 +23,24 @@ DECLARE_LOG(logger, "qassembler.HeftyGraph");
 HeftyGraph::HeftyGraph(uint16_t kmerLength) {
 	this->nextGraphId = 0;
 	this->kmerLength = kmerLength;
+	this->beginStateTransitionSum = 0;
+	this->beginStateTransitionSumValid = false;
 	this->trackReads = HeftyGraph::DONT_TRACK_READS;
 }
 
 HeftyGraph::HeftyGraph(uint16_t kmerLength, HeftyGraph::TrackReads trackReads) {
 	this->nextGraphId = 0;
 	this->kmerLength = kmerLength;
+	this->beginStateTransitionSum = 0;
+	this->beginStateTransitionSumValid = false;
 	this->trackReads = trackReads;
 }
 
 HeftyGraph::HeftyGraph(uint16_t kmerLength, HeftyGraph::TrackReads trackReads, boost::shared_ptr<PreHash> guide, std::size_t minEdgeWeight) {
 	this->nextGraphId = 0;
 	this->kmerLength = kmerLength;
+	this->beginStateTransitionSum = 0;
+	this->beginStateTransitionSumValid = false;
 	this->trackReads = trackReads;
 	this->guide = guide;
 	this->minEdgeWeight = minEdgeWeight;
@@ -55,37 +62,87 @@ HeftyGraph::getReverseReads() {
 
 void
 HeftyGraph::addReadToGraph(boost::shared_ptr<Sequence> read) {
-	std::string sequence = read->getSequence();
-	std::string name = read->getName();
-	std::size_t id = read->getID();
-
-
 	if (read->getLength() < kmerLength) {
 		throw ReadSizeException("Read is too short.");
 	}
 
+	addStrandsToGraph(read->getSequence(), read->getReverseComplement(), read->getID(), read->getName());
+}
+
+std::size_t
+HeftyGraph::addReadsToGraph(const ReadBatch &batch) {
+	std::size_t added = 0;
+	std::string forward, reverse, name;
+	boost::unordered_set<std::size_t> counted;
+
+	for (std::size_t i = 0; i < batch.size(); i++) {
+		bool addedRead = false;
+		std::size_t copies = batch.copies(i);
+
+		// records that were collapsed into another record have already been counted there.
+		if (copies == 0) {
+			continue;
+		}
+
+		counted.clear();
+
+		// each segment of a read is added as if it were a read of its own.
+		for (std::size_t s = 0; s < batch.segments(i); s++) {
+			boost::string_ref segment = batch.segment(i, s);
+			if (segment.size() < kmerLength) {
+				continue;
+			}
+
+			// the strings are reused from read to read, so they're only allocated as they grow.
+			forward.assign(segment.begin(), segment.end());
+			reverse.assign(batch.segmentReverseComplement(i, s).begin(), batch.segmentReverseComplement(i, s).end());
+
+			// the first copy of a read adds its k-mers to the graph, the other copies only add weight.
+			if (!batch.repeated(i)) {
+				name.assign(batch.name(i).begin(), batch.name(i).end());
+				addStrandsToGraph(forward, reverse, batch.id(i), name);
+				copies = batch.copies(i) - 1;
+			}
+
+			if (copies > 0) {
+				addCopiesToGraph(forward, copies, counted);
+				addCopiesToGraph(reverse, copies, counted);
+			}
+			addedRead = true;
+		}
+
+		if (addedRead) {
+			added += batch.copies(i);
+		}
+	}
+
+	return added;
+}
+
+void
+HeftyGraph::addStrandsToGraph(const std::string &forward, const std::string &reverse, std::size_t id, const std::string &name) {
+	// adding a read changes the structure of the graph.
+	this->beginStateTransitionSumValid = false;
+
 	if (guide) {
 		TRACE(logger, "Adding read with guide.");
 		DEBUG(logger, "Adding read " << name << " (forward) to graph.");
-		addReadToGraphWithGuide(sequence, id, name, Kmer::FORWARD);
-		sequence = read->getReverseComplement();
+		addReadToGraphWithGuide(forward, id, name, Kmer::FORWARD);
 		DEBUG(logger, "Adding read " << name << " (reverse) to graph.");
-		addReadToGraphWithGuide(sequence, id, name, Kmer::REVERSE);
+		addReadToGraphWithGuide(reverse, id, name, Kmer::REVERSE);
 	} else {
 		// if we have no guide, blindly add the read to the graph.
 		TRACE(logger, "Adding read without guide.");
 		DEBUG(logger, "Adding read " << name << " (forward) to graph.");
-		addReadToGraph(sequence, id, name, Kmer::FORWARD);
-		sequence = read->getReverseComplement();
+		addReadToGraph(forward, id, name, Kmer::FORWARD);
 		DEBUG(logger, "Adding read " << name << " (reverse complement) read to graph.");
-		addReadToGraph(sequence, id, name, Kmer::REVERSE);
+		addReadToGraph(reverse, id, name, Kmer::REVERSE);
 		DEBUG(logger, "Finished adding read " << name << " to graph.");
 	}
 }
 
 void
-HeftyGraph::addReadToGraphWithGuide(std::string sequence, std::size_t source, std::string sourceName, Kmer::Strand direction) {
-	std::string upperSequence = boost::to_upper_copy(sequence);
+HeftyGraph::addReadToGraphWithGuide(const std::string &upperSequence, std::size_t source, const std::string &sourceName, Kmer::Strand direction) {
 	if (upperSequence.size() == kmerLength) {
 		if (guide->kmerCount(upperSequence) > minEdgeWeight) {
 			addSingleKmerToGraph(upperSequence, source, sourceName, direction);
@@ -115,11 +172,9 @@ HeftyGraph::addReadToGraphWithGuide(std::string sequence, std::size_t source, st
 }
 
 void
-HeftyGraph::addReadToGraph(std::string sequence, std::size_t source, std::string sourceName, 
+HeftyGraph::addReadToGraph(const std::string &upperSequence, std::size_t source, const std::string &sourceName,
 			   Kmer::Strand direction) {
-
-	std::string upperSequence = boost::to_upper_copy(sequence);
-	TRACE(logger, "Adding [" << sequence << "] to graph (kmerLength = " << kmerLength << ").");
+	TRACE(logger, "Adding [" << upperSequence << "] to graph (kmerLength = " << kmerLength << ").");
 	if (upperSequence.size() == kmerLength) {
 		TRACE(logger, "Adding single kmer to graph.");
 		addSingleKmerToGraph(upperSequence, source, sourceName, direction);	
@@ -153,6 +208,60 @@ HeftyGraph::addSingleKmerToGraph(std::string kmer, std::size_t source, std::stri
 	addReference(hash, source, direction, graph);
 }
 
+void
+HeftyGraph::addCopiesToGraph(const std::string &upperSequence, std::size_t copies, boost::unordered_set<std::size_t> &counted) {
+	boost::shared_ptr<SkinnyGraph> previousGraph;
+	SkinnyGraph::Vertex previousVertex = SkinnyGraph::Graph::null_vertex();
+	boost::shared_ptr<Kmer> previous;
+	std::size_t previousPos = 0;
+
+	// no k-mers are added here, so the structure of the graph doesn't change; only the weights
+	// that adding the read again would have increased are increased.
+	this->beginStateTransitionSumValid = false;
+
+	for (std::size_t i = 0; i + kmerLength <= upperSequence.size(); i++) {
+		std::size_t hash = qassembler::hash(upperSequence.substr(i, kmerLength));
+		boost::shared_ptr<SkinnyGraph> graph;
+		SkinnyGraph::Vertex vertex;
+
+		// k-mers can be missing if the guide kept them out of the graph.
+		if (!hashExists(hash)) {
+			previous.reset();
+			continue;
+		}
+
+		boost::tie(graph, vertex) = getGraphAndVertexForHash(hash);
+		boost::shared_ptr<SequenceNode> node = graph->node(vertex);
+		std::size_t pos = node->findKmer(hash);
+		boost::shared_ptr<Kmer> kmer = node->getKmer(pos);
+
+		// a k-mer is only counted once per read, no matter how often it appears in the read.
+		if (counted.insert(hash).second) {
+			kmer->addCopies(copies);
+		}
+
+		if (previous && previousGraph == graph) {
+			SkinnyGraph::Edge e;
+			bool exists = false;
+
+			previous->addTransition(upperSequence[i + kmerLength - 1], copies);
+
+			// the pair only crosses an edge if the k-mers are at the ends of their nodes.
+			if (previousVertex != vertex && previousPos + 1 == graph->node(previousVertex)->kmerCount() && pos == 0) {
+				boost::tie(e, exists) = boost::edge(previousVertex, vertex, *graph->graph());
+			}
+			if (exists) {
+				graph->edge(e)->increaseWeight(copies);
+			}
+		}
+
+		previous = kmer;
+		previousGraph = graph;
+		previousVertex = vertex;
+		previousPos = pos;
+	}
+}
+
 boost::shared_ptr<SkinnyGraph>
 HeftyGraph::findOrCreateGraph(std::size_t hash, std::string kmer, std::string sourceName, std::size_t source, std::size_t position,
 			      Kmer::Strand direction) {
@@ -252,6 +361,7 @@ boost::tuple<boost::shared_ptr<SkinnyGraph>, SkinnyGraph::Vertex>
 HeftyGraph::createGraphWithVertex(std::size_t hash, std::string sequence, std::string sourceName, std::size_t sourceId, std::size_t position, Kmer::Strand direction) {
 	boost::shared_ptr<SkinnyGraph> g = boost::make_shared<SkinnyGraph>(getNextGraphId());
 	SkinnyGraph::Vertex v = g->createFirstSequenceNode(hash, sequence, sourceName, sourceId, position, direction);
+	this->graphs.insert(std::make_pair(g->getId(), g));
 	
 	// return the tuple
 	return boost::make_tuple(g, v);
@@ -267,20 +377,14 @@ HeftyGraph::hashExists(std::size_t hash) {
 	return this->biGraphs.count(hash) > 0;
 }
 
-std::set<boost::shared_ptr<SkinnyGraph> >
+const HeftyGraph::Graphs &
 HeftyGraph::getGraphs() {
-	std::set<boost::shared_ptr<SkinnyGraph> > graphSet;
-
-	BOOST_FOREACH (boost::shared_ptr<SkinnyGraph> g, this->biGraphs.getValues()) {
-		graphSet.insert(g);
-	}
-
-	return graphSet;
+	return this->graphs;
 }
 
 int
 HeftyGraph::numGraphs() {
-	return getGraphs().size();
+	return this->graphs.size();
 }
 
 boost::shared_ptr<SkinnyGraph>
@@ -315,6 +419,7 @@ HeftyGraph::updateReferences(boost::shared_ptr<SkinnyGraph> from, boost::shared_
 		this->biGraphs.put(k, to);
 	}
 	this->biGraphs.clear(from);
+	this->graphs.erase(from->getId());
 
 	TRACE(logger, "Updating references of forward read identifiers to graphs.");
 	// update forward reads:
@@ -336,23 +441,55 @@ HeftyGraph::getNextGraphId() {
 	return this->nextGraphId++;
 }
 
+void
+HeftyGraph::rescaleWeights(const CoverageNormalizer &normalizer) {
+	this->beginStateTransitionSumValid = false;
+	BOOST_FOREACH (const Graphs::value_type &entry, this->graphs) {
+		boost::shared_ptr<SkinnyGraph> g = entry.second;
+
+		BOOST_FOREACH (SkinnyGraph::Vertex v, g->getVertexIterators()) {
+			BOOST_FOREACH (boost::shared_ptr<Kmer> k, g->node(v)->getKmers()) {
+				std::size_t count = k->getCount();
+				k->addCopies(static_cast<std::size_t>(std::floor(count * normalizer.scale(k->getHash()) + 0.5)) - count);
+			}
+		}
+
+		// an edge is crossed by the reads that go on into the first k-mer of its target.
+		BOOST_FOREACH (SkinnyGraph::Edge e, g->edges()) {
+			boost::shared_ptr<Kmer> k = g->node(boost::target(e, *g->graph()))->getKmer(0);
+			boost::shared_ptr<WeightedEdge> edge = g->edge(e);
+			edge->setWeight(static_cast<std::size_t>(std::floor(edge->getWeight() * normalizer.scale(k->getHash()) + 0.5)));
+		}
+	}
+}
+
 void
 HeftyGraph::removeEdgesBelowThreshold(std::size_t threshold) {
-	BOOST_FOREACH(boost::shared_ptr<SkinnyGraph> g, this->getGraphs()) {
-		g->removeSmallEdges(threshold);
+	this->beginStateTransitionSumValid = false;
+	BOOST_FOREACH(const Graphs::value_type &entry, this->graphs) {
+		entry.second->removeSmallEdges(threshold);
 	}
 }
 
 void
 HeftyGraph::removeGraphsShorterThan(std::size_t threshold) {
-	BOOST_FOREACH(boost::shared_ptr<SkinnyGraph> g, this->getGraphs()) {
+	this->beginStateTransitionSumValid = false;
+	Graphs::iterator it = this->graphs.begin();
+	while (it != this->graphs.end()) {
+		boost::shared_ptr<SkinnyGraph> g = it->second;
+		bool remove = false;
 		if (g->numVertices() == 1) {
 			SkinnyGraph::Vertices iterator;
 			boost::tie(iterator, boost::tuples::ignore) = g->getVertexIterators();
 			boost::shared_ptr<SequenceNode> n = g->node(*iterator);
-			if (n->kmerCount() + kmerLength < threshold) {
-				this->biGraphs.clear(g);
-			}
+			remove = n->kmerCount() + kmerLength < threshold;
+		}
+
+		if (remove) {
+			this->biGraphs.clear(g);
+			this->graphs.erase(it++);
+		} else {
+			++it;
 		}
 	}
 }
@@ -364,15 +501,43 @@ HeftyGraph::getKmerLength() {
 
 void
 HeftyGraph::lockEdgeWeights() {
-	BOOST_FOREACH(boost::shared_ptr<SkinnyGraph> g, this->getGraphs()) {
-		g->lockEdgeWeights();
+	BOOST_FOREACH(const Graphs::value_type &entry, this->graphs) {
+		entry.second->lockEdgeWeights();
 	}
 }
 
 void
 HeftyGraph::resetEdgeWeights() {
-	BOOST_FOREACH(boost::shared_ptr<SkinnyGraph> g, this->getGraphs()) {
-		g->resetEdgeWeights();
+	BOOST_FOREACH(const Graphs::value_type &entry, this->graphs) {
+		entry.second->resetEdgeWeights();
+	}
+}
+
+std::size_t
+HeftyGraph::getBeginStateTransitionSum() {
+	if (!this->beginStateTransitionSumValid) {
+		this->beginStateTransitionSum = computeBeginStateTransitionSum();
+		this->beginStateTransitionSumValid = true;
 	}
+
+	return this->beginStateTransitionSum;
+}
+
+std::size_t
+HeftyGraph::computeBeginStateTransitionSum() {
+	std::size_t transitionSum = 0;
+
+	BOOST_FOREACH (const Graphs::value_type &entry, this->graphs) {
+		boost::shared_ptr<SkinnyGraph> g = entry.second;
+		BOOST_FOREACH (SkinnyGraph::Vertex v, g->getVertexIterators()) {
+			if (boost::in_degree (v, *g->graph()) == 0) {
+				boost::shared_ptr<SequenceNode> node = g->node(v);
+				boost::shared_ptr<Kmer> firstMer = node->getKmer(0);
+				transitionSum += firstMer->getCount();
+			}
+		}
+	}
+
+	return transitionSum;
 }
 #endif // HEFTY_GRAPH
@@ -9,14 +9,18 @@
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/cstdint.hpp>
+#include <map>
 
 #include "Graph/SkinnyGraph.hh"
 #include "Lookup/GraphLookup.hh"
 #include "PreHash/PreHash.hh"
 #include "Sequence/Sequence.hh"
+#include "Sequence/ReadBatch.hh"
+#include "Sequence/CoverageNormalizer.hh"
 
 #include "Logging/Logging.hh"
 
@@ -61,22 +65,33 @@ public:
 	typedef GraphLookup<std::size_t, boost::shared_ptr<SkinnyGraph> > ReadLookup;
 	// used for determining which hash is found in which graph
 	typedef GraphLookup<std::size_t, boost::shared_ptr<SkinnyGraph> > HashLookup;
+	// the live sub-graphs in this graph, ordered by their identifier
+	typedef std::map<std::size_t, boost::shared_ptr<SkinnyGraph> > Graphs;
 
 	/**
 	 * Add the supplied read to the graph. 
 	 * @param read the read to add to the graph.
 	 */
 	void addReadToGraph(boost::shared_ptr<Sequence> read);
+	/**
+	 * Add the segments of every read in a (normalised) batch to the graph. Segments shorter
+	 * than the k-mer length are skipped. If the batch was collapsed, the k-mers of a record are
+	 * added once and the other copies that it stands for only add weight to the graph.
+	 * @param batch the reads to add to the graph.
+	 * @return the number of reads (including collapsed copies) that had at least one segment added.
+	 */
+	std::size_t addReadsToGraph(const ReadBatch &batch);
 	/** 
 	 * Count the number of sub-graphs in the graph.
 	 * @return the number of sub-graphs present in the graph.
 	 */
 	int numGraphs();
 	/** 
-	 * Get a collection of the graphs in this graph.
-	 * @return references to all graphs found in this graph.
+	 * Get a collection of the graphs in this graph. The collection is maintained as graphs
+	 * are created, merged and removed, so it is not copied on each call.
+	 * @return references to all graphs found in this graph, ordered by graph identifier.
 	 */
-	std::set<boost::shared_ptr<SkinnyGraph> > getGraphs();
+	const Graphs &getGraphs();
 	/**
 	 * Get the graphs in this graph by their read identifiers in the forward direction.
 	 * @return a key-value store identifying which graph a read was placed in.
@@ -88,6 +103,14 @@ public:
 	 */
 	ReadLookup getReverseReads();
 
+	/**
+	 * Scale the k-mer counts and edge weights of a graph built from normalised reads back up
+	 * to the coverage of all of the reads, k-mer by k-mer. Should be called after all reads
+	 * have been added and before edge weights are locked.
+	 * @param normalizer the normalizer that the reads were passed through.
+	 */
+	void rescaleWeights(const CoverageNormalizer &normalizer);
+
 	/**
 	 * Remove edges from all graphs that are below a threshold value.
 	 * @param threshold the edge weight threshold.
@@ -121,11 +144,22 @@ public:
 	 * Reset all edge weights to the locked snapshot.
 	 */
 	void resetEdgeWeights();
+
+	/**
+	 * Get the sum of the edges that transition from the 'start' state to a state that
+	 * emits symbols across all graphs (the total number of instances of the first kmer in
+	 * vertices which have no incoming edges). The sum is computed once and cached until
+	 * the structure of the graph changes.
+	 * @return the total sum of 'edge weights' for vertices that have no incoming edges.
+	 */
+	std::size_t getBeginStateTransitionSum();
 private:
 	/** internal graph identifier */
 	std::size_t nextGraphId;
 	/** bidirectional lookup for graphs */
 	HashLookup biGraphs;
+	/** the graphs that are currently live in this graph */
+	Graphs graphs;
 	/** a mapping of reads to graphs */
 	ReadLookup read2graphForward;
 	/** a mapping of reads to graphs */
@@ -138,30 +172,59 @@ private:
 	boost::shared_ptr<PreHash> guide;
 	/** should we bother keeping track of where reads are being put? */
 	TrackReads trackReads;
+	/** cached sum of transitions from the 'start' state */
+	std::size_t beginStateTransitionSum;
+	/** is the cached begin state transition sum up to date? */
+	bool beginStateTransitionSumValid;
 	/**
 	 * Get the next unique identifier for graphs and increment.
 	 * @return the next unique identifier for graphs.
 	 */
 	std::size_t getNextGraphId();
 
+	/**
+	 * Compute the total sum of transitions from the start state to a state in the model.
+	 * @return the total sum of edges.
+	 */
+	std::size_t computeBeginStateTransitionSum();
+
+	/**
+	 * Add both strands of a read to the graph.
+	 * @param forward the (upper-case) sequence of the read
+	 * @param reverse the reverse complement of the sequence of the read
+	 * @param source the identifier of the read
+	 * @param sourceName the name of the read
+	 */
+	void addStrandsToGraph(const std::string &forward, const std::string &reverse, std::size_t source, const std::string &sourceName);
+
+	/**
+	 * Add the weight of more copies of a sequence that was already added to the graph: the
+	 * counts of its k-mers, the transitions between them and the edges that they cross are
+	 * increased as if the sequence had been added that many more times.
+	 * @param sequence the (upper-case) sequence to add copies of
+	 * @param copies the number of copies to add
+	 * @param counted the k-mers already counted for this read (updated)
+	 */
+	void addCopiesToGraph(const std::string &sequence, std::size_t copies, boost::unordered_set<std::size_t> &counted);
+
 	/**
 	 * Add a read to the graph by manually specifying all components instead of supplying
 	 * an AMOS read.
-	 * @param sequence the sequence of the read to add
+	 * @param sequence the (upper-case) sequence of the read to add
 	 * @param source the AMOS identifier where this read came from
 	 * @param sourceName the external AMOS identifier where this read came from
 	 * @param direction the orientation of the read when adding this sequence
 	 */
-	void addReadToGraph(std::string sequence, std::size_t source, std::string sourceName, Kmer::Strand direction);
+	void addReadToGraph(const std::string &sequence, std::size_t source, const std::string &sourceName, Kmer::Strand direction);
 
 	/**
 	 * Add a sequence from a read to the graph using the guide.
-	 * @param sequence the sequence of the read to add
+	 * @param sequence the (upper-case) sequence of the read to add
 	 * @param source the AMOS identifier where this read came from
 	 * @param sourceName the external AMOS identifier where this read came from
 	 * @param direction the orientation of the read when adding this sequence
 	 */
-	void addReadToGraphWithGuide(std::string sequence, std::size_t source, std::string sourceName, Kmer::Strand direction);
+	void addReadToGraphWithGuide(const std::string &sequence, std::size_t source, const std::string &sourceName, Kmer::Strand direction);
 
 	/**
 	 * Add a pair of overlapping k-mers to the graph.
@@ -53,6 +53,16 @@ SequenceNode::fullSequence() {
 	return sequence;
 }
 
+std::size_t
+SequenceNode::fullSequenceLength(std::size_t kmerLength) {
+	if (kmers.empty()) {
+		return 0;
+	}
+
+	// the first k-mer contributes its whole sequence, every other k-mer contributes one base.
+	return kmerLength + kmers.size() - 1;
+}
+
 std::string
 SequenceNode::sequence() {
 	std::string sequence = "";
@@ -53,6 +53,12 @@ public:
 	 * @return the complete sequence represented by this node (including the complete first kmer).
 	 */
 	std::string fullSequence();
+	/**
+	 * Get the length of the full sequence represented by this node, without constructing it.
+	 * @param kmerLength the length of the k-mers in the graph
+	 * @return the length of fullSequence().
+	 */
+	std::size_t fullSequenceLength(std::size_t kmerLength);
 	/**
 	 * Get the name for this node.
 	 * @return the name for this node.
@@ -0,0 +1,74 @@
+/*
+ * File:   StrongComponents.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef STRONG_COMPONENTS_CC
+#define STRONG_COMPONENTS_CC
+
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <boost/graph/strong_components.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include "Graph/StrongComponents.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+DECLARE_LOG(logger, "qassembler.StrongComponents");
+
+StrongComponents::StrongComponents(boost::shared_ptr<SkinnyGraph> g) : numCyclic(0) {
+	SkinnyGraph::Graph &graph = *g->graph();
+
+	BOOST_FOREACH (SkinnyGraph::Vertex v, g->getVertexIterators()) {
+		this->indices[v] = this->vertices.size();
+		this->vertices.push_back(v);
+	}
+
+	// the vertex list is a set, so the graph has no vertex_index property for the algorithm to use.
+	boost::associative_property_map<boost::unordered_map<SkinnyGraph::Vertex, std::size_t> > indexMap(this->indices);
+	this->components.resize(this->vertices.size());
+	std::size_t count = 0;
+	if (!this->vertices.empty()) {
+		count = boost::strong_components(graph, boost::make_iterator_property_map(this->components.begin(), indexMap),
+						 boost::vertex_index_map(indexMap));
+	}
+
+	std::vector<std::size_t> sizes(count, 0);
+	BOOST_FOREACH (std::size_t c, this->components) {
+		sizes[c]++;
+	}
+	this->cyclicComponents.resize(count, false);
+	for (std::size_t c = 0; c < count; c++) {
+		this->cyclicComponents[c] = sizes[c] > 1;
+	}
+
+	this->condensed.resize(count);
+	BOOST_FOREACH (SkinnyGraph::Edge e, g->edges()) {
+		std::size_t source = this->components[this->indices[boost::source(e, graph)]];
+		std::size_t target = this->components[this->indices[boost::target(e, graph)]];
+
+		if (source == target) {
+			// edges inside a component (including edges from a vertex to itself) form cycles.
+			this->cyclicComponents[source] = true;
+		} else if (std::find(this->condensed[source].begin(), this->condensed[source].end(), target) == this->condensed[source].end()) {
+			this->condensed[source].push_back(target);
+		}
+	}
+
+	this->numCyclic = std::count(this->cyclicComponents.begin(), this->cyclicComponents.end(), true);
+	DEBUG(logger, "Graph [" << g->getId() << "] has [" << count << "] strong components, [" << this->numCyclic << "] of which are cyclic.");
+}
+
+std::size_t
+StrongComponents::vertexIndex(SkinnyGraph::Vertex v) {
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t>::iterator it = this->indices.find(v);
+
+	if (it == this->indices.end()) {
+		throw InvalidGraphStateException("Vertex is not part of the graph that strong components were computed for.");
+	}
+
+	return it->second;
+}
+
+#endif // STRONG_COMPONENTS_CC
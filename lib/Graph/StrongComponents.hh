@@ -0,0 +1,92 @@
+/*
+ * File:   StrongComponents.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef STRONG_COMPONENTS_HH
+#define STRONG_COMPONENTS_HH
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Graph/SkinnyGraph.hh"
+#include "Logging/Logging.hh"
+
+/**
+ * The strongly connected components of a sub-graph and the graph of components that
+ * is left when each component is condensed into a single vertex. Vertices are given
+ * dense identifiers (0 to numVertices() - 1) so that algorithms walking the graph can
+ * keep per-vertex state in flat arrays.
+ */
+class StrongComponents {
+public:
+	/**
+	 * Constructor. Computes the components of the graph in its current state (every edge
+	 * is considered, whether or not its weight has been consumed).
+	 * @param g the graph to find components in
+	 */
+	StrongComponents(boost::shared_ptr<SkinnyGraph> g);
+
+	/**
+	 * Get the dense identifier for a vertex.
+	 * @param v the vertex in question
+	 * @return the dense identifier of v
+	 */
+	std::size_t vertexIndex(SkinnyGraph::Vertex v);
+
+	/**
+	 * Get the vertex for a dense identifier.
+	 * @param index the dense identifier
+	 * @return the vertex with that identifier
+	 */
+	SkinnyGraph::Vertex vertex(std::size_t index) { return vertices[index]; }
+
+	/**
+	 * Get the component that a vertex belongs to. Components are numbered in reverse
+	 * topological order of the condensed graph: an edge between two components always
+	 * leads from a higher numbered component to a lower numbered component.
+	 * @param index the dense identifier of the vertex
+	 * @return the component of the vertex
+	 */
+	std::size_t component(std::size_t index) { return components[index]; }
+
+	/**
+	 * Does a component contain a cycle (more than one vertex, or a vertex with an edge to itself)?
+	 * @param component the component in question
+	 * @return true if a path can visit a vertex in the component more than once.
+	 */
+	bool cyclic(std::size_t component) { return cyclicComponents[component]; }
+
+	/**
+	 * Get the components that can be reached from a component by following a single edge.
+	 * @param component the component in question
+	 * @return the (distinct) successors of the component in the condensed graph.
+	 */
+	const std::vector<std::size_t> &successors(std::size_t component) { return condensed[component]; }
+
+	/** is the graph free of cycles? */
+	bool acyclic() { return numCyclic == 0; }
+	/** how many vertices are in the graph? */
+	std::size_t numVertices() { return vertices.size(); }
+	/** how many components are in the graph? */
+	std::size_t numComponents() { return condensed.size(); }
+	/** how many components contain a cycle? */
+	std::size_t numCyclicComponents() { return numCyclic; }
+private:
+	/** the vertices, by dense identifier */
+	std::vector<SkinnyGraph::Vertex> vertices;
+	/** the dense identifier of each vertex */
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t> indices;
+	/** the component of each vertex, by dense identifier */
+	std::vector<std::size_t> components;
+	/** whether or not each component contains a cycle */
+	std::vector<bool> cyclicComponents;
+	/** the successors of each component in the condensed graph */
+	std::vector<std::vector<std::size_t> > condensed;
+	/** the number of components that contain a cycle */
+	std::size_t numCyclic;
+};
+
+#endif // STRONG_COMPONENTS_HH
@@ -0,0 +1,273 @@
+/*
+ * File:   BgzfReader.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BGZF_READER_CC
+#define BGZF_READER_CC
+
+#include <cstring>
+#include <algorithm>
+#include <zlib.h>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+#include "IO/BgzfReader.hh"
+#include "Exception/InvalidInputException.hh"
+
+/** the size of the fixed part of a gzip header (up to and including XLEN) */
+#define GZIP_HEADER_SIZE 12
+/** the size of the gzip trailer (CRC32 and ISIZE) */
+#define GZIP_TRAILER_SIZE 8
+/** the gzip flag that says there are extra fields in the header */
+#define GZIP_FLAG_EXTRA 4
+/** how many blocks are inflated together (a block holds at most 64KB) */
+#define BLOCKS_PER_GROUP 16
+/** how many groups can be waiting for each inflater thread */
+#define GROUPS_PER_THREAD 4
+
+/**
+ * Read a little-endian unsigned integer.
+ * @param bytes the first byte of the integer
+ * @param size the number of bytes in the integer
+ * @return the integer.
+ */
+static std::size_t littleEndian(const char *bytes, std::size_t size) {
+	std::size_t value = 0;
+	for (std::size_t i = size; i > 0; i--) {
+		value = (value << 8) | static_cast<unsigned char>(bytes[i - 1]);
+	}
+	return value;
+}
+
+/**
+ * Does a gzip header start the way that every BGZF header does?
+ * @param header the fixed part of the header
+ * @return true if the header has the gzip magic number and extra fields.
+ */
+static bool bgzfHeader(const char *header) {
+	return static_cast<unsigned char>(header[0]) == 0x1f && static_cast<unsigned char>(header[1]) == 0x8b
+		&& header[2] == Z_DEFLATED && (header[3] & GZIP_FLAG_EXTRA);
+}
+
+BgzfReader::BgzfReader(std::string filename, std::size_t threads) :
+		file(filename.c_str(), std::ios::binary), ordered(std::max<std::size_t>(threads, 1) * GROUPS_PER_THREAD),
+		uninflated(std::max<std::size_t>(threads, 1) * GROUPS_PER_THREAD), offset(0), consumed(0) {
+	if (!file) {
+		throw InvalidInputException("Couldn't open [" + filename + "].");
+	}
+
+	this->threads.create_thread(boost::bind(&BgzfReader::readBlocks, this));
+	for (std::size_t t = 0; t < std::max<std::size_t>(threads, 1); t++) {
+		this->threads.create_thread(boost::bind(&BgzfReader::inflateBlocks, this));
+	}
+}
+
+BgzfReader::~BgzfReader() {
+	this->ordered.close();
+	this->uninflated.close();
+	this->threads.join_all();
+}
+
+int
+BgzfReader::read(void *buffer, unsigned length) {
+	char *out = static_cast<char*>(buffer);
+	std::size_t copied = 0;
+
+	// kseq takes a short read to mean eof, so keep going across groups until the buffer is full.
+	while (copied < length) {
+		if (!current || offset == current->data.size()) {
+			boost::shared_ptr<Group> group;
+			if (!this->ordered.pop(group)) {
+				boost::unique_lock<boost::mutex> lock(this->errorMutex);
+				if (!this->error.empty()) {
+					throw InvalidInputException(this->error);
+				}
+				break;
+			}
+
+			boost::unique_lock<boost::mutex> lock(group->mutex);
+			while (!group->inflated) {
+				group->done.wait(lock);
+			}
+			if (!group->error.empty()) {
+				throw InvalidInputException(group->error);
+			}
+			current = group;
+			offset = 0;
+			consumed = group->end;
+			continue;
+		}
+
+		std::size_t n = std::min<std::size_t>(length - copied, current->data.size() - offset);
+		std::memcpy(out + copied, &current->data[offset], n);
+		offset += n;
+		copied += n;
+	}
+
+	return copied;
+}
+
+std::size_t
+BgzfReader::position() {
+	return this->consumed;
+}
+
+bool
+BgzfReader::isBgzf(std::string filename) {
+	std::ifstream in(filename.c_str(), std::ios::binary);
+	char header[GZIP_HEADER_SIZE];
+
+	if (!in.read(header, GZIP_HEADER_SIZE) || !bgzfHeader(header)) {
+		return false;
+	}
+
+	std::vector<char> extra(littleEndian(header + 10, 2));
+	if (extra.empty() || !in.read(&extra[0], extra.size())) {
+		return false;
+	}
+
+	return blockSize(&extra[0], extra.size()) > 0;
+}
+
+void
+BgzfReader::readBlocks() {
+	std::size_t end = 0;
+
+	try {
+		while (true) {
+			boost::shared_ptr<Group> group = boost::make_shared<Group>();
+			while (group->starts.size() < BLOCKS_PER_GROUP && readBlock(*group));
+			if (group->starts.empty()) {
+				break;
+			}
+			end += group->compressed.size();
+			group->end = end;
+
+			// the caller gets groups in order; waiting here is what holds the reader back.
+			if (!this->ordered.push(group) || !this->uninflated.push(group)) {
+				break;
+			}
+		}
+	} catch (std::exception &e) {
+		boost::unique_lock<boost::mutex> lock(this->errorMutex);
+		this->error = e.what();
+	}
+
+	this->ordered.close();
+	this->uninflated.close();
+}
+
+bool
+BgzfReader::readBlock(Group &group) {
+	char header[GZIP_HEADER_SIZE];
+
+	this->file.read(header, GZIP_HEADER_SIZE);
+	if (this->file.gcount() == 0) {
+		return false;
+	}
+	if (this->file.gcount() < GZIP_HEADER_SIZE || !bgzfHeader(header)) {
+		throw InvalidInputException("Found a block that isn't a BGZF block.");
+	}
+
+	std::size_t start = group.compressed.size();
+	std::size_t extraLength = littleEndian(header + 10, 2);
+	group.compressed.insert(group.compressed.end(), header, header + GZIP_HEADER_SIZE);
+	group.compressed.resize(start + GZIP_HEADER_SIZE + extraLength);
+	if (extraLength > 0 && !this->file.read(&group.compressed[start + GZIP_HEADER_SIZE], extraLength)) {
+		throw InvalidInputException("The file ends in the middle of a BGZF block.");
+	}
+
+	std::size_t size = blockSize(&group.compressed[start + GZIP_HEADER_SIZE], extraLength);
+	if (size < GZIP_HEADER_SIZE + extraLength + GZIP_TRAILER_SIZE) {
+		throw InvalidInputException("Found a block that isn't a BGZF block.");
+	}
+
+	group.compressed.resize(start + size);
+	std::size_t rest = size - GZIP_HEADER_SIZE - extraLength;
+	if (!this->file.read(&group.compressed[start + GZIP_HEADER_SIZE + extraLength], rest)) {
+		throw InvalidInputException("The file ends in the middle of a BGZF block.");
+	}
+	group.starts.push_back(start);
+
+	return true;
+}
+
+std::size_t
+BgzfReader::blockSize(const char *extra, std::size_t length) {
+	std::size_t i = 0;
+
+	// the extra fields are a list of (SI1, SI2, SLEN, data); BGZF adds a BC field with the
+	// size of the whole block, less one.
+	while (i + 4 <= length) {
+		std::size_t fieldLength = littleEndian(extra + i + 2, 2);
+		if (extra[i] == 'B' && extra[i + 1] == 'C' && fieldLength == 2 && i + 6 <= length) {
+			return littleEndian(extra + i + 4, 2) + 1;
+		}
+		i += 4 + fieldLength;
+	}
+
+	return 0;
+}
+
+void
+BgzfReader::inflateBlocks() {
+	boost::shared_ptr<Group> group;
+
+	while (this->uninflated.pop(group)) {
+		inflateGroup(group);
+	}
+}
+
+void
+BgzfReader::inflateGroup(boost::shared_ptr<Group> group) {
+	std::string error;
+	std::vector<char> data;
+	z_stream stream;
+
+	std::memset(&stream, 0, sizeof(stream));
+	// BGZF blocks are raw deflate streams wrapped in our own reading of the gzip header.
+	if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+		error = "Couldn't start inflating a BGZF block.";
+	}
+
+	for (std::size_t b = 0; b < group->starts.size() && error.empty(); b++) {
+		std::size_t start = group->starts[b];
+		std::size_t end = b + 1 < group->starts.size() ? group->starts[b + 1] : group->compressed.size();
+		const char *block = &group->compressed[start];
+		std::size_t payload = GZIP_HEADER_SIZE + littleEndian(block + 10, 2);
+		std::size_t crc = littleEndian(block + (end - start) - GZIP_TRAILER_SIZE, 4);
+		std::size_t size = littleEndian(block + (end - start) - 4, 4);
+
+		if (size == 0) {
+			// the empty block at the end of a BGZF file.
+			continue;
+		}
+
+		std::size_t out = data.size();
+		data.resize(out + size);
+		inflateReset(&stream);
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(block + payload));
+		stream.avail_in = (end - start) - payload - GZIP_TRAILER_SIZE;
+		stream.next_out = reinterpret_cast<Bytef*>(&data[out]);
+		stream.avail_out = size;
+
+		if (inflate(&stream, Z_FINISH) != Z_STREAM_END || stream.avail_out != 0) {
+			error = "Couldn't inflate a BGZF block; the file is corrupt.";
+		} else if (crc32(0L, reinterpret_cast<Bytef*>(&data[out]), size) != crc) {
+			error = "A BGZF block failed its CRC check; the file is corrupt.";
+		}
+	}
+	inflateEnd(&stream);
+
+	boost::unique_lock<boost::mutex> lock(group->mutex);
+	group->data.swap(data);
+	group->error = error;
+	group->inflated = true;
+	// the compressed blocks aren't needed anymore.
+	std::vector<char>().swap(group->compressed);
+	group->done.notify_all();
+}
+
+#endif // BGZF_READER_CC
@@ -0,0 +1,135 @@
+/*
+ * File:   BgzfReader.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BGZF_READER_HH
+#define BGZF_READER_HH
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "Util/BoundedQueue.hh"
+
+/**
+ * Decompress a BGZF (block gzip, as written by bgzip) file on a pool of threads. A BGZF file
+ * is a series of gzip members that each record their own compressed size, so the blocks can
+ * be found without decompressing anything, and inflated independently. A reader thread cuts
+ * the file into groups of blocks, the inflater threads inflate the groups, and the caller
+ * reads the decompressed bytes (in the same order as the file) with read.
+ */
+class BgzfReader : private boost::noncopyable {
+public:
+	/**
+	 * Constructor. Starts decompressing immediately.
+	 * @param filename the BGZF file to read
+	 * @param threads the number of threads that inflate blocks (at least 1)
+	 * @throws InvalidInputException if the file can't be opened.
+	 */
+	BgzfReader(std::string filename, std::size_t threads);
+
+	/**
+	 * Destructor. Stops decompressing and waits for the background threads to finish.
+	 */
+	~BgzfReader();
+
+	/**
+	 * Copy the next decompressed bytes of the file (the same as gzread).
+	 * @param buffer where to copy the bytes
+	 * @param length the maximum number of bytes to copy
+	 * @return the number of bytes copied, or 0 at eof.
+	 * @throws InvalidInputException if the file isn't valid BGZF or is corrupt.
+	 */
+	int read(void *buffer, unsigned length);
+
+	/**
+	 * How much of the (compressed) file has been read? This is the end of the last group of
+	 * blocks that read has started on.
+	 * @return the number of bytes of the file that have been read.
+	 */
+	std::size_t position();
+
+	/**
+	 * Is this file BGZF? Only the first block is checked.
+	 * @param filename the file to check
+	 * @return true if the file starts with a BGZF block.
+	 */
+	static bool isBgzf(std::string filename);
+private:
+	/** a group of blocks, waiting to be inflated */
+	struct Group {
+		Group() : inflated(false), end(0) {}
+		/** the compressed blocks, one after another */
+		std::vector<char> compressed;
+		/** where each block starts in compressed */
+		std::vector<std::size_t> starts;
+		/** the decompressed bytes of all of the blocks */
+		std::vector<char> data;
+		/** have the blocks been inflated? */
+		bool inflated;
+		/** why inflating failed (empty if it didn't) */
+		std::string error;
+		/** the position in the file after the last block in the group */
+		std::size_t end;
+		/** protects inflated, error and data */
+		boost::mutex mutex;
+		/** signalled when the group is inflated */
+		boost::condition_variable done;
+	};
+
+	/** the file that we're reading */
+	std::ifstream file;
+	/** groups in the order they were read, for the caller */
+	BoundedQueue<boost::shared_ptr<Group> > ordered;
+	/** groups waiting to be inflated, for the inflaters */
+	BoundedQueue<boost::shared_ptr<Group> > uninflated;
+	/** the reader and inflater threads */
+	boost::thread_group threads;
+	/** the group that the caller is reading from */
+	boost::shared_ptr<Group> current;
+	/** how much of the current group the caller has read */
+	std::size_t offset;
+	/** the end of the current group in the file */
+	std::size_t consumed;
+	/** why reading failed (empty if it didn't) */
+	std::string error;
+	/** protects error */
+	boost::mutex errorMutex;
+
+	/** Read groups of blocks from the file until eof (or until the reader is stopped). */
+	void readBlocks();
+
+	/**
+	 * Read the next block from the file onto the end of a group.
+	 * @param group the group to add the block to
+	 * @return false at eof.
+	 * @throws InvalidInputException if the block isn't a BGZF block.
+	 */
+	bool readBlock(Group &group);
+
+	/** Inflate groups until there are no more. */
+	void inflateBlocks();
+
+	/**
+	 * Find the size of a BGZF block from the extra fields in its gzip header.
+	 * @param extra the extra fields
+	 * @param length the length of the extra fields
+	 * @return the size of the whole block, or 0 if the extra fields don't give it.
+	 */
+	static std::size_t blockSize(const char *extra, std::size_t length);
+
+	/**
+	 * Inflate all of the blocks in a group, and tell the caller that they're ready.
+	 * @param group the group to inflate
+	 */
+	void inflateGroup(boost::shared_ptr<Group> group);
+};
+
+#endif // BGZF_READER_HH
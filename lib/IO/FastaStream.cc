@@ -8,56 +8,216 @@
 #ifndef FASTA_STREAM_CC
 #define FASTA_STREAM_CC
 
+#include <zlib.h>
+#include <boost/filesystem.hpp>
+
 #include "IO/FastaStream.hh"
+#include "IO/kseq.h"
+#include "Exception/InvalidInputException.hh"
+
+DECLARE_LOG(logger, "qassembler.FastaStream");
+
+/**
+ * Where kseq reads from: a compressed file read through zlib, or a BGZF file inflated on a
+ * pool of threads.
+ */
+struct CompressedInput {
+	gzFile handle;
+	BgzfReader *blocks;
+};
+
+/**
+ * Read from a compressed file for kseq (the same as gzread).
+ * @param input the file to read
+ * @param buffer where to copy the decompressed bytes
+ * @param length the maximum number of bytes to copy
+ * @return the number of bytes copied, or 0 at eof.
+ */
+static int
+readCompressed(CompressedInput *input, void *buffer, unsigned length) {
+	if (input->blocks) {
+		return input->blocks->read(buffer, length);
+	}
+
+	return gzread(input->handle, buffer, length);
+}
+
+KSEQ_INIT(CompressedInput*, readCompressed)
+
+struct KseqStream {
+	/** where kseq reads from */
+	CompressedInput input;
+	/** a place for temporarily storing sequence records from kseq */
+	kseq_t *seq;
+};
 
 FastaStream::FastaStream() {}
 
-FastaStream::FastaStream(std::string filename) {
+FastaStream::FastaStream(std::string filename, std::size_t inflateThreads) : kseq(NULL) {
 	this->filename = filename;
-	handle = gzopen(filename.c_str(), "r");
-	kseq_init(handle);
-	k_seq = kseq_init(handle);
+
+	if (MappedFile::mappable(filename)) {
+		DEBUG(logger, "Mapping [" << filename << "] into memory.");
+		file = boost::make_shared<MappedFile>(filename);
+		reader = boost::make_shared<MappedReader>(file, 0, file->size());
+		return;
+	}
+
+	kseq = new KseqStream();
+	kseq->input.handle = NULL;
+	kseq->input.blocks = NULL;
+	if (inflateThreads > 0 && BgzfReader::isBgzf(filename)) {
+		DEBUG(logger, "Inflating BGZF blocks of [" << filename << "] on [" << inflateThreads << "] threads.");
+		blocks = boost::make_shared<BgzfReader>(filename, inflateThreads);
+		kseq->input.blocks = blocks.get();
+	} else {
+		DEBUG(logger, "Reading [" << filename << "] with zlib.");
+		kseq->input.handle = gzopen(filename.c_str(), "r");
+	}
+	kseq->seq = kseq_init(&kseq->input);
 }
 
 FastaStream::~FastaStream() {
-	kseq_destroy(k_seq);
-	gzclose(handle);
+	if (kseq) {
+		kseq_destroy(kseq->seq);
+		if (kseq->input.handle) {
+			gzclose(kseq->input.handle);
+		}
+		delete kseq;
+	}
 }
 
 
 boost::shared_ptr<Sequence>
 FastaStream::nextSeq() {
 	boost::shared_ptr<Sequence> seq;
-	int status;
-
-	status = kseq_read(k_seq);
+	std::string sequence, name, comment, qual;
 
-	if (status >= 0) {
-		std::string sequence (k_seq->seq.s, k_seq->seq.l);
-		std::string name (k_seq->name.s, k_seq->name.l);
-		std::string comment (k_seq->comment.s, k_seq->comment.l);
-		std::string qual (k_seq->qual.s, k_seq->qual.l);
+	if (nextRecord(sequence, name, comment, qual)) {
 		seq = boost::make_shared<Sequence>(sequence, name, comment, qual);
 	} 
 
 	return seq;
 }
 
+boost::shared_ptr<ReadBatch>
+FastaStream::nextBatch(std::size_t n) {
+	boost::shared_ptr<ReadBatch> batch = boost::make_shared<ReadBatch>(n);
+
+	if (reader) {
+		MappedRecord record;
+		while (batch->size() < n && reader->next(record)) {
+			batch->add(record.sequence, record.name, record.comment, record.qual);
+		}
+	}
+
+	while (!reader && batch->size() < n && kseq_read(kseq->seq) >= 0) {
+		kseq_t *k_seq = kseq->seq;
+		batch->add(boost::string_ref(k_seq->seq.s, k_seq->seq.l), boost::string_ref(k_seq->name.s, k_seq->name.l),
+			   boost::string_ref(k_seq->comment.s, k_seq->comment.l), boost::string_ref(k_seq->qual.s, k_seq->qual.l));
+	}
+
+	if (batch->empty()) {
+		batch.reset();
+	}
+
+	return batch;
+}
+
+bool
+FastaStream::nextRecord(std::string &sequence, std::string &name, std::string &comment, std::string &qual) {
+	if (reader) {
+		MappedRecord record;
+		if (!reader->next(record)) {
+			return false;
+		}
+
+		sequence.assign(record.sequence.begin(), record.sequence.end());
+		name.assign(record.name.begin(), record.name.end());
+		comment.assign(record.comment.begin(), record.comment.end());
+		qual.assign(record.qual.begin(), record.qual.end());
+
+		return true;
+	}
+
+	if (kseq_read(kseq->seq) < 0) {
+		return false;
+	}
+
+	kseq_t *k_seq = kseq->seq;
+	sequence.assign(k_seq->seq.s, k_seq->seq.l);
+	name.assign(k_seq->name.s, k_seq->name.l);
+	comment.assign(k_seq->comment.s, k_seq->comment.l);
+	qual.assign(k_seq->qual.s, k_seq->qual.l);
+
+	return true;
+}
+
 std::size_t
-FastaStream::seqCount() {
-	std::size_t count = 0;
-	int status;
+FastaStream::size() {
+	return size(this->filename);
+}
+
+std::size_t
+FastaStream::size(std::string filename) {
+	boost::system::error_code error;
+	boost::uintmax_t size = boost::filesystem::file_size(filename, error);
+
+	return error ? 0 : size;
+}
+
+bool
+FastaStream::isMapped() {
+	return reader.get() != NULL;
+}
+
+bool
+FastaStream::nextRange(std::size_t n, std::size_t &begin, std::size_t &end) {
+	if (!reader) {
+		throw InvalidInputException("Only files that are mapped into memory can be read in ranges.");
+	}
+
+	std::size_t start = reader->position();
+	if (reader->skip(n) == 0) {
+		return false;
+	}
+	begin = start;
+	end = reader->position();
+
+	return true;
+}
+
+boost::shared_ptr<ReadBatch>
+FastaStream::readRange(std::size_t begin, std::size_t end) const {
+	if (!file) {
+		throw InvalidInputException("Only files that are mapped into memory can be read in ranges.");
+	}
+
+	boost::shared_ptr<ReadBatch> batch = boost::make_shared<ReadBatch>();
+	MappedReader range(file, begin, end);
+	MappedRecord record;
+	while (range.next(record)) {
+		batch->add(record.sequence, record.name, record.comment, record.qual);
+	}
+
+	return batch;
+}
+
+std::size_t
+FastaStream::position() {
+	if (reader) {
+		return reader->position();
+	}
 
-	while ((status = kseq_read(k_seq)) >= 0) {
-		count++;
+	if (blocks) {
+		return blocks->position();
 	}
 
-	gzclose(handle);
-	handle = gzopen(filename.c_str(), "r");
-	kseq_init(handle);
-	k_seq = kseq_init(handle);
+	// gzoffset asks the operating system for the file position, so callers should only
+	// check it every so often.
+	z_off_t offset = gzoffset(kseq->input.handle);
 
-	return count;
+	return offset < 0 ? 0 : offset;
 }
 
 #endif // FASTA_STREAM_CC
@@ -8,27 +8,37 @@
 #ifndef FASTA_STREAM_HH
 #define FASTA_STREAM_HH
 
-#include <zlib.h>
-#include "IO/kseq.h"
-
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 
 #include "Sequence/Sequence.hh"
+#include "Sequence/ReadBatch.hh"
+#include "IO/MappedFile.hh"
+#include "IO/MappedReader.hh"
+#include "IO/BgzfReader.hh"
 #include "QAssemblerConfig.h"
 
 #define LOGGER_NAME "qassembler.FastaStream"
 #include "Logging/Logging.hh"
 
-KSEQ_INIT(gzFile, gzread)
+/** a compressed file parsed by kseq (defined in FastaStream.cc, so only that file includes kseq). */
+struct KseqStream;
 
+/**
+ * Read records from a fasta/fastq file. Uncompressed files are mapped into memory and parsed
+ * in place, BGZF files can be inflated on a pool of threads, and anything else (gzip-compressed
+ * files, pipes) is read through zlib. Compressed files are parsed by kseq.
+ */
 class FastaStream {
 public:
 	/**
-	 * Constructor, specifying fasta file to read.
+	 * Constructor, specifying fasta file to read. The way the file is read is chosen from
+	 * its contents.
 	 * @param filename the fasta file to read.
+	 * @param inflateThreads the number of threads that inflate a BGZF file (if 0, BGZF
+	 * files are read through zlib like any other gzip file).
 	 */
-	FastaStream(std::string filename);
+	FastaStream(std::string filename, std::size_t inflateThreads = 0);
 
 	/**
 	 * Destructor. Closes the file handle as required.
@@ -43,21 +53,88 @@ public:
 	boost::shared_ptr<Sequence> nextSeq();
 
 	/**
-	 * How many FASTA records are in this file?
-	 * @return the number of FASTA records in the file.
+	 * Read the next records in the fasta file into one batch. The records are copied straight
+	 * from the file buffers into the batch; the batch still needs to be normalised.
+	 * @param n the maximum number of records to read
+	 * @return the records that were read, or NULL at eof.
+	 */
+	boost::shared_ptr<ReadBatch> nextBatch(std::size_t n);
+
+	/**
+	 * Read the next record in the fasta file without constructing a Sequence. The strings are
+	 * assigned to, so callers that keep reusing the same strings avoid most allocations.
+	 * @param sequence set to the bases of the record
+	 * @param name set to the name of the record
+	 * @param comment set to the comment of the record
+	 * @param qual set to the qualities of the record (empty for fasta records)
+	 * @return false at eof (and nothing is set).
+	 */
+	bool nextRecord(std::string &sequence, std::string &name, std::string &comment, std::string &qual);
+
+	/**
+	 * Is the file mapped into memory? Only mapped files can be cut into ranges.
+	 * @return true if the file is mapped.
+	 */
+	bool isMapped();
+
+	/**
+	 * Skip over the next records in the file without copying them, reporting the range of
+	 * the file that they cover. The range can be parsed with readRange (on any thread).
+	 * @param n the maximum number of records in the range
+	 * @param begin set to the position of the start of the range
+	 * @param end set to the position of the end of the range
+	 * @return false at eof (and nothing is set).
+	 * @throws InvalidInputException if the file isn't mapped.
+	 */
+	bool nextRange(std::size_t n, std::size_t &begin, std::size_t &end);
+
+	/**
+	 * Read all of the records in a range of the file into one batch. This doesn't move the
+	 * stream, so ranges can be read by several threads at once.
+	 * @param begin the position of the start of the range
+	 * @param end the position of the end of the range
+	 * @return the records in the range (not yet normalised).
+	 * @throws InvalidInputException if the file isn't mapped.
 	 */
-	std::size_t seqCount();
+	boost::shared_ptr<ReadBatch> readRange(std::size_t begin, std::size_t end) const;
+
+	/**
+	 * How large is this file on disk? For compressed files, this is the compressed size.
+	 * @return the size of the file in bytes (or 0 if it can't be determined).
+	 */
+	std::size_t size();
+
+	/**
+	 * How large is a file on disk, without opening it?
+	 * @param filename the file to check
+	 * @return the size of the file in bytes (or 0 if it can't be determined).
+	 */
+	static std::size_t size(std::string filename);
+
+	/**
+	 * How much of this file has been read? Together with size(), this can be used to report
+	 * progress without reading the file twice. For compressed files, this is the number of
+	 * compressed bytes read (including any bytes that are buffered but not yet parsed).
+	 * @return the number of bytes of the file that have been read.
+	 */
+	std::size_t position();
 private:
 	/**
 	 * Default constructor, shouldn't be called.
 	 */
 	FastaStream();
 
-	/** a file handle for the fasta file. */
-	gzFile handle;
+	/** the blocks of the file, if it's BGZF and inflated on a pool of threads. */
+	boost::shared_ptr<BgzfReader> blocks;
+
+	/** the file and the current record, as parsed by kseq (NULL if the file is mapped). */
+	KseqStream *kseq;
+
+	/** the file, if it is mapped into memory. */
+	boost::shared_ptr<MappedFile> file;
 
-	/** a place for temporarily storing sequence records from kseq. */
-	kseq_t *k_seq;
+	/** the reader for the mapped file. */
+	boost::shared_ptr<MappedReader> reader;
 
 	/** the name of the file we're working with. */
 	std::string filename;
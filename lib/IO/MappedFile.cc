@@ -0,0 +1,76 @@
+/*
+ * File:   MappedFile.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef MAPPED_FILE_CC
+#define MAPPED_FILE_CC
+
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <boost/filesystem.hpp>
+
+#include "IO/MappedFile.hh"
+#include "Exception/InvalidInputException.hh"
+
+/** the first two bytes of every gzip (and bgzf) file */
+#define GZIP_MAGIC_1 '\x1f'
+#define GZIP_MAGIC_2 '\x8b'
+
+MappedFile::MappedFile(std::string filename) : start(NULL), length(0) {
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw InvalidInputException("Couldn't open [" + filename + "].");
+	}
+
+	struct stat info;
+	if (fstat(fd, &info) < 0 || info.st_size == 0) {
+		close(fd);
+		throw InvalidInputException("Couldn't find the size of [" + filename + "].");
+	}
+	length = info.st_size;
+
+	void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping keeps the file open on its own.
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		throw InvalidInputException("Couldn't map [" + filename + "] into memory.");
+	}
+	// records are read from front to back, so let the kernel read ahead aggressively.
+	madvise(mapping, length, MADV_SEQUENTIAL);
+	start = static_cast<const char*>(mapping);
+}
+
+MappedFile::~MappedFile() {
+	munmap(const_cast<char*>(start), length);
+}
+
+const char *
+MappedFile::data() const {
+	return start;
+}
+
+std::size_t
+MappedFile::size() const {
+	return length;
+}
+
+bool
+MappedFile::mappable(std::string filename) {
+	boost::system::error_code error;
+	if (!boost::filesystem::is_regular_file(filename, error) || boost::filesystem::file_size(filename, error) == 0 || error) {
+		return false;
+	}
+
+	char magic[2] = { 0, 0 };
+	std::ifstream in(filename.c_str(), std::ios::binary);
+	in.read(magic, 2);
+
+	return in && !(magic[0] == GZIP_MAGIC_1 && magic[1] == GZIP_MAGIC_2);
+}
+
+#endif // MAPPED_FILE_CC
@@ -0,0 +1,50 @@
+/*
+ * File:   MappedFile.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef MAPPED_FILE_HH
+#define MAPPED_FILE_HH
+
+#include <string>
+#include <boost/noncopyable.hpp>
+
+/**
+ * A whole (uncompressed) file mapped into memory, read-only. The mapping is released when the
+ * object is destroyed, so anything that points into the file should hold on to the object.
+ */
+class MappedFile : private boost::noncopyable {
+public:
+	/**
+	 * Constructor. Maps the file into memory.
+	 * @param filename the file to map
+	 * @throws InvalidInputException if the file can't be opened or mapped.
+	 */
+	MappedFile(std::string filename);
+
+	/**
+	 * Destructor. Unmaps the file.
+	 */
+	~MappedFile();
+
+	/** the first byte of the file */
+	const char *data() const;
+	/** the size of the file in bytes */
+	std::size_t size() const;
+
+	/**
+	 * Can (and should) this file be mapped? Only regular, non-empty files that aren't
+	 * gzip-compressed are worth mapping.
+	 * @param filename the file to check
+	 * @return true if the file can be mapped.
+	 */
+	static bool mappable(std::string filename);
+private:
+	/** the start of the mapping */
+	const char *start;
+	/** the length of the mapping */
+	std::size_t length;
+};
+
+#endif // MAPPED_FILE_HH
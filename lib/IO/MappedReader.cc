@@ -0,0 +1,134 @@
+/*
+ * File:   MappedReader.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef MAPPED_READER_CC
+#define MAPPED_READER_CC
+
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+
+#include "IO/MappedReader.hh"
+#include "Exception/InvalidInputException.hh"
+
+MappedReader::MappedReader(boost::shared_ptr<MappedFile> file, std::size_t begin, std::size_t end) : file(file) {
+	this->limit = file->data() + file->size();
+	this->cursor = file->data() + std::min(begin, file->size());
+	this->end = file->data() + std::min(end, file->size());
+}
+
+bool
+MappedReader::next(MappedRecord &record) {
+	return read(record, true);
+}
+
+std::size_t
+MappedReader::skip(std::size_t n) {
+	MappedRecord record;
+	std::size_t skipped = 0;
+
+	while (skipped < n && read(record, false)) {
+		skipped++;
+	}
+
+	return skipped;
+}
+
+std::size_t
+MappedReader::position() const {
+	return cursor - file->data();
+}
+
+bool
+MappedReader::read(MappedRecord &record, bool join) {
+	if (!findHeader()) {
+		return false;
+	}
+
+	// the name runs up to the first whitespace after the '>' or '@', and the comment is the
+	// rest of the line (just like kseq).
+	boost::string_ref header = nextLine();
+	header.remove_prefix(1);
+	std::size_t space = 0;
+	while (space < header.size() && !isspace(static_cast<unsigned char>(header[space]))) {
+		space++;
+	}
+	record.name = header.substr(0, space);
+	record.comment = space < header.size() ? header.substr(space + 1) : boost::string_ref();
+	record.sequence = record.qual = boost::string_ref();
+
+	std::size_t length = 0;
+	std::size_t lines = 0;
+	while (cursor < limit && *cursor != '>' && *cursor != '@' && *cursor != '+') {
+		boost::string_ref line = nextLine();
+		if (!line.empty()) {
+			if (join) {
+				append(record.sequence, this->sequence, lines++, line);
+			}
+			length += line.size();
+		}
+	}
+
+	if (cursor < limit && *cursor == '+') {
+		// quality lines can start with anything (even '@' or '+'), so they're counted instead.
+		nextLine();
+		std::size_t qualLength = 0;
+		lines = 0;
+		while (qualLength < length && cursor < limit) {
+			boost::string_ref line = nextLine();
+			if (join) {
+				append(record.qual, this->qual, lines++, line);
+			}
+			qualLength += line.size();
+		}
+		if (qualLength != length) {
+			throw InvalidInputException("Record [" + record.name.to_string() + "] doesn't have as many qualities as bases.");
+		}
+	}
+
+	return true;
+}
+
+bool
+MappedReader::findHeader() {
+	while (cursor < end && *cursor != '>' && *cursor != '@') {
+		nextLine();
+	}
+
+	return cursor < end;
+}
+
+boost::string_ref
+MappedReader::nextLine() {
+	const char *start = cursor;
+	// memchr is vectorised by the C library, which makes it by far the fastest way to find
+	// the end of a line.
+	const char *newline = static_cast<const char*>(memchr(cursor, '\n', limit - cursor));
+	const char *stop = newline ? newline : limit;
+
+	cursor = newline ? newline + 1 : limit;
+	while (stop > start && isspace(static_cast<unsigned char>(stop[-1]))) {
+		stop--;
+	}
+
+	return boost::string_ref(start, stop - start);
+}
+
+void
+MappedReader::append(boost::string_ref &view, std::string &buffer, std::size_t lines, boost::string_ref line) {
+	if (lines == 0) {
+		view = line;
+		return;
+	}
+
+	if (lines == 1) {
+		buffer.assign(view.begin(), view.end());
+	}
+	buffer.append(line.begin(), line.end());
+	view = buffer;
+}
+
+#endif // MAPPED_READER_CC
@@ -0,0 +1,110 @@
+/*
+ * File:   MappedReader.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef MAPPED_READER_HH
+#define MAPPED_READER_HH
+
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include "IO/MappedFile.hh"
+
+/**
+ * The parts of a fasta/fastq record, as views. The views point either into the mapped file
+ * or into the reader that produced them, and are valid until the next record is read.
+ */
+struct MappedRecord {
+	boost::string_ref sequence, name, comment, qual;
+};
+
+/**
+ * Read fasta/fastq records from a range of a mapped file. Records are found by scanning the
+ * file line-by-line with memchr; a record whose sequence (and qualities) fits on one line is
+ * handed out without copying anything, and only multi-line records are joined together.
+ *
+ * A reader can be limited to a range of the file, so that several readers can parse one file
+ * at once. A reader reads every record whose header starts inside of its range, so a file is
+ * split safely by cutting it at the positions reported by skip.
+ */
+class MappedReader {
+public:
+	/**
+	 * Constructor.
+	 * @param file the file to read
+	 * @param begin the position to start looking for records at (this should be the start of
+	 * a line)
+	 * @param end the position after which no more records are started
+	 */
+	MappedReader(boost::shared_ptr<MappedFile> file, std::size_t begin, std::size_t end);
+
+	/**
+	 * Read the next record in the range.
+	 * @param record set to the parts of the record
+	 * @return false if there are no more records in the range.
+	 * @throws InvalidInputException if a fastq record doesn't have as many qualities as bases.
+	 */
+	bool next(MappedRecord &record);
+
+	/**
+	 * Skip over records without joining their lines. Together with position, this is how a
+	 * file is cut into ranges.
+	 * @param n the maximum number of records to skip
+	 * @return the number of records that were skipped.
+	 * @throws InvalidInputException if a fastq record doesn't have as many qualities as bases.
+	 */
+	std::size_t skip(std::size_t n);
+
+	/**
+	 * Where is the reader in the file?
+	 * @return the position just after the last record that was read.
+	 */
+	std::size_t position() const;
+private:
+	/** the file that we're reading */
+	boost::shared_ptr<MappedFile> file;
+	/** the next character to read */
+	const char *cursor;
+	/** no records are started at or after this position */
+	const char *end;
+	/** the end of the file */
+	const char *limit;
+	/** where sequences spanning several lines are joined */
+	std::string sequence;
+	/** where qualities spanning several lines are joined */
+	std::string qual;
+
+	/**
+	 * Read the next record.
+	 * @param record set to the parts of the record
+	 * @param join should lines be joined? If not, only the name of the record is set.
+	 * @return false if there are no more records in the range.
+	 */
+	bool read(MappedRecord &record, bool join);
+
+	/**
+	 * Skip lines until the cursor is at the start of a header line.
+	 * @return false if there are no more headers in the range.
+	 */
+	bool findHeader();
+
+	/**
+	 * Read the next line.
+	 * @return the line, without its newline or any trailing whitespace.
+	 */
+	boost::string_ref nextLine();
+
+	/**
+	 * Append a line to a view, joining it into a buffer when the view already has a line.
+	 * @param view the view to append to
+	 * @param buffer where to join lines
+	 * @param lines the number of lines already in the view
+	 * @param line the line to append
+	 */
+	void append(boost::string_ref &view, std::string &buffer, std::size_t lines, boost::string_ref line);
+};
+
+#endif // MAPPED_READER_HH
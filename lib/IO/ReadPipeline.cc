@@ -0,0 +1,166 @@
+/*
+ * File:   ReadPipeline.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_PIPELINE_CC
+#define READ_PIPELINE_CC
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+#include "IO/ReadPipeline.hh"
+#include "IO/FastaStream.hh"
+#include "Exception/InvalidInputException.hh"
+
+DECLARE_LOG(logger, "qassembler.ReadPipeline");
+
+ReadPipeline::ReadPipeline(std::vector<std::string> filenames, std::size_t parserThreads, std::size_t batchSize,
+			   std::size_t queueDepth, std::size_t inflateThreads, boost::shared_ptr<ReadFilter> filter) :
+		filenames(filenames), totalSize(0), inflateThreads(inflateThreads), filter(filter), batchSize(batchSize > 0 ? batchSize : 1), ordered(queueDepth), unparsed(queueDepth),
+		parseInReader(parserThreads == 0), consumed(0) {
+	for (std::size_t f = 0; f < filenames.size(); f++) {
+		this->totalSize += FastaStream::size(filenames[f]);
+	}
+
+	this->threads.create_thread(boost::bind(&ReadPipeline::read, this));
+	for (std::size_t t = 0; t < parserThreads; t++) {
+		this->threads.create_thread(boost::bind(&ReadPipeline::parse, this));
+	}
+}
+
+ReadPipeline::~ReadPipeline() {
+	// closing the queues stops the reader; the parsers finish the batches that were already read.
+	this->ordered.close();
+	this->unparsed.close();
+	this->threads.join_all();
+}
+
+boost::shared_ptr<ReadBatch>
+ReadPipeline::nextBatch() {
+	boost::shared_ptr<Batch> batch;
+
+	if (!this->ordered.pop(batch)) {
+		boost::unique_lock<boost::mutex> lock(this->errorMutex);
+		if (!this->error.empty()) {
+			throw InvalidInputException(this->error);
+		}
+		return boost::shared_ptr<ReadBatch>();
+	}
+
+	boost::unique_lock<boost::mutex> lock(batch->mutex);
+	while (!batch->parsed) {
+		batch->done.wait(lock);
+	}
+	if (!batch->error.empty()) {
+		throw InvalidInputException(batch->error);
+	}
+	this->consumed = batch->position;
+
+	return batch->reads;
+}
+
+std::size_t
+ReadPipeline::size() {
+	return this->totalSize;
+}
+
+std::size_t
+ReadPipeline::position() {
+	return this->consumed;
+}
+
+void
+ReadPipeline::read() {
+	try {
+		boost::shared_ptr<FastaStream> next;
+		std::size_t offset = 0;
+
+		for (std::size_t f = 0; f < this->filenames.size(); f++) {
+			boost::shared_ptr<FastaStream> stream = next ? next : boost::make_shared<FastaStream>(this->filenames[f], this->inflateThreads);
+			// open the next file while this one is read, so that (if it's BGZF) it's already
+			// being inflated when this one runs out.
+			next.reset();
+			if (f + 1 < this->filenames.size()) {
+				next = boost::make_shared<FastaStream>(this->filenames[f + 1], this->inflateThreads);
+			}
+
+			DEBUG(logger, "Reading [" << this->filenames[f] << "].");
+			if (!readFile(stream, f, offset)) {
+				break;
+			}
+			offset += stream->size();
+		}
+	} catch (std::exception &e) {
+		boost::unique_lock<boost::mutex> lock(this->errorMutex);
+		this->error = e.what();
+	}
+
+	this->ordered.close();
+	this->unparsed.close();
+}
+
+bool
+ReadPipeline::readFile(boost::shared_ptr<FastaStream> stream, std::size_t source, std::size_t offset) {
+	while (true) {
+		boost::shared_ptr<Batch> batch = boost::make_shared<Batch>();
+
+		if (this->parseInReader || !stream->isMapped()) {
+			batch->reads = stream->nextBatch(this->batchSize);
+			if (!batch->reads) {
+				return true;
+			}
+		} else if (!stream->nextRange(this->batchSize, batch->begin, batch->end)) {
+			return true;
+		} else {
+			batch->stream = stream;
+		}
+		batch->source = source;
+		batch->position = offset + stream->position();
+
+		if (this->parseInReader) {
+			parseBatch(batch);
+		}
+		// the caller gets batches in order; waiting here is what holds the reader back.
+		if (!this->ordered.push(batch) || (!this->parseInReader && !this->unparsed.push(batch))) {
+			return false;
+		}
+	}
+}
+
+void
+ReadPipeline::parse() {
+	boost::shared_ptr<Batch> batch;
+
+	while (this->unparsed.pop(batch)) {
+		parseBatch(batch);
+	}
+}
+
+void
+ReadPipeline::parseBatch(boost::shared_ptr<Batch> batch) {
+	std::string error;
+
+	try {
+		if (!batch->reads) {
+			batch->reads = batch->stream->readRange(batch->begin, batch->end);
+			// the records are copied out of the file, so it can be closed as soon as it's read.
+			batch->stream.reset();
+		}
+		batch->reads->setSource(batch->source);
+		batch->reads->normalise();
+		if (this->filter) {
+			batch->reads->filter(*this->filter);
+		}
+	} catch (std::exception &e) {
+		error = e.what();
+	}
+
+	boost::unique_lock<boost::mutex> lock(batch->mutex);
+	batch->error = error;
+	batch->parsed = true;
+	batch->done.notify_all();
+}
+
+#endif // READ_PIPELINE_CC
@@ -0,0 +1,147 @@
+/*
+ * File:   ReadPipeline.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_PIPELINE_HH
+#define READ_PIPELINE_HH
+
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "Sequence/ReadBatch.hh"
+#include "Sequence/ReadFilter.hh"
+#include "Util/BoundedQueue.hh"
+
+class FastaStream;
+
+/**
+ * Read sequences from fasta/fastq files on background threads. A reader thread decompresses
+ * the files (one after the other) and splits them into batches of records, a pool of parser
+ * threads normalises the batches, and the caller takes the normalised batches (in the same
+ * order as the files) with nextBatch. When a file is mapped into memory, the reader only finds
+ * where each batch starts and ends, and the parsers parse the batches too. At most queueDepth
+ * batches are in flight at once, so the reader waits for the caller when the caller falls
+ * behind.
+ *
+ * Each batch is tagged with the index of the file that it came from, so reads in different
+ * files get identifiers in different namespaces.
+ */
+class ReadPipeline {
+public:
+	/**
+	 * Constructor. Starts reading immediately.
+	 * @param filenames the fasta/fastq files to read, in order
+	 * @param parserThreads the number of threads that normalise batches (if 0, the reader
+	 * thread normalises them itself)
+	 * @param batchSize the number of records in each batch
+	 * @param queueDepth the maximum number of batches that are read but not yet consumed
+	 * @param inflateThreads the number of threads that inflate a BGZF file (if 0, the reader
+	 * thread decompresses it)
+	 * @param filter splits the reads in each batch into the segments that k-mers are taken
+	 * from (if NULL, reads aren't split)
+	 */
+	ReadPipeline(std::vector<std::string> filenames, std::size_t parserThreads, std::size_t batchSize, std::size_t queueDepth,
+		     std::size_t inflateThreads = 0, boost::shared_ptr<ReadFilter> filter = boost::shared_ptr<ReadFilter>());
+
+	/**
+	 * Destructor. Stops reading and waits for the background threads to finish.
+	 */
+	~ReadPipeline();
+
+	/**
+	 * The next batch of records in the file.
+	 * @return the next (normalised) batch, or NULL at eof.
+	 * @throws InvalidInputException if a background thread couldn't read or parse the file.
+	 */
+	boost::shared_ptr<ReadBatch> nextBatch();
+
+	/**
+	 * How large are the files on disk?
+	 * @return the total size of the files in bytes.
+	 */
+	std::size_t size();
+
+	/**
+	 * How much of the files has been consumed? This is the position of the reader (counting
+	 * all of the files before the one it's in) when it finished the most recent batch.
+	 * @return the number of bytes of the files that have been consumed.
+	 */
+	std::size_t position();
+private:
+	/** a batch of records, waiting to be normalised */
+	struct Batch {
+		Batch() : parsed(false), position(0), source(0), begin(0), end(0) {}
+		/** the records in the batch (NULL until the range of the batch is parsed) */
+		boost::shared_ptr<ReadBatch> reads;
+		/** the file the records are in (only kept until the batch is parsed) */
+		boost::shared_ptr<FastaStream> stream;
+		/** has the batch been normalised? */
+		bool parsed;
+		/** why parsing failed (empty if it didn't) */
+		std::string error;
+		/** the position of the reader after reading this batch */
+		std::size_t position;
+		/** the index of the file the records are in */
+		std::size_t source;
+		/** the range of the (mapped) file that the records are in */
+		std::size_t begin, end;
+		/** protects parsed and error */
+		boost::mutex mutex;
+		/** signalled when the batch is parsed */
+		boost::condition_variable done;
+	};
+
+	/** the files that we're reading */
+	std::vector<std::string> filenames;
+	/** the total size of the files */
+	std::size_t totalSize;
+	/** the number of threads that inflate each BGZF file */
+	std::size_t inflateThreads;
+	/** splits the reads in each batch into segments (may be NULL) */
+	boost::shared_ptr<ReadFilter> filter;
+	/** the number of records in each batch */
+	std::size_t batchSize;
+	/** batches in the order they were read, for the caller */
+	BoundedQueue<boost::shared_ptr<Batch> > ordered;
+	/** batches waiting to be parsed, for the parsers */
+	BoundedQueue<boost::shared_ptr<Batch> > unparsed;
+	/** should the reader parse batches itself? */
+	bool parseInReader;
+	/** the reader and parser threads */
+	boost::thread_group threads;
+	/** the position of the reader after the batch most recently taken by the caller */
+	std::size_t consumed;
+	/** why reading failed (empty if it didn't) */
+	std::string error;
+	/** protects error */
+	boost::mutex errorMutex;
+
+	/** Read batches from each of the files until eof (or until the pipeline is stopped). */
+	void read();
+
+	/**
+	 * Read batches from one file until eof.
+	 * @param stream the file to read
+	 * @param source the index of the file
+	 * @param offset the total size of the files before this one
+	 * @return false if the pipeline was stopped.
+	 */
+	bool readFile(boost::shared_ptr<FastaStream> stream, std::size_t source, std::size_t offset);
+
+	/** Parse batches until there are no more. */
+	void parse();
+
+	/**
+	 * Parse, normalise and filter the reads in a batch, and tell the caller that they're ready.
+	 * @param batch the batch to parse
+	 */
+	void parseBatch(boost::shared_ptr<Batch> batch);
+};
+
+#endif // READ_PIPELINE_HH
@@ -9,18 +9,20 @@
 
 #include "Kmer.hh"
 
-Kmer::Kmer() {}
+Kmer::Kmer() : copies(0) {}
 
 Kmer::Kmer(Kmer *mer) {
 	this->hash = mer->hash;
 	this->base = mer->base;
 	this->sources = mer->sources;
+	this->copies = mer->copies;
 }
 
 Kmer::Kmer(std::size_t hash, char base, std::size_t source, std::size_t position, Strand strand) {
 	this->hash = hash;
 	this->base = base;
 	this->sources[source] = std::make_pair(position, strand);
+	this->copies = 0;
 }
 
 std::size_t
@@ -58,9 +60,14 @@ Kmer::setSources(boost::unordered_map<std::size_t /* readIdentifier */, Kmer::So
 	this->sources = sources;
 }
 
+void
+Kmer::addCopies(std::size_t copies) {
+	this->copies += copies;
+}
+
 std::size_t
 Kmer::getCount() {
-	return this->sources.size();
+	return this->sources.size() + this->copies;
 }
 
 Kmer::Source
@@ -74,8 +81,8 @@ Kmer::getSequence() {
 }
 
 void
-Kmer::addTransition(char base) {
-	this->transitions[base]++;
+Kmer::addTransition(char base, std::size_t count) {
+	this->transitions[base] += count;
 }
 
 std::size_t
@@ -88,6 +88,12 @@ public:
 	 * @param sources the new list of sources where this kmer can be found.
 	 */
 	void setSources(boost::unordered_map<std::size_t /* readIdentifier */, Source /* position */> sources);
+	/**
+	 * Count more observations of this kmer without recording where they came from (i.e., for copies
+	 * of a read that was already added to the graph).
+	 * @param copies the number of extra observations.
+	 */
+	void addCopies(std::size_t copies);
 	/**
 	 * Find out how many times this kmer has been observed in the data set.
 	 * @return the number of instances of this kmer in the data set.
@@ -103,8 +109,9 @@ public:
 	 * Add a new transition that was observed in the data set (i.e., if you add a kmer pair where the next kmer has a
 	 * most significant base of 'G', then you've observed a transition from this kmer to 'G').
 	 * @param base the base where you transitioned to.
+	 * @param count the number of times the transition was observed.
 	 */
-	void addTransition(char base);
+	void addTransition(char base, std::size_t count = 1);
 
 	/**
 	 * Determine how many transitions were made for a certain nucleotide.
@@ -119,6 +126,8 @@ private:
 	std::size_t hash;
 	/** the collection of places where this kmer was observed in the data set */
 	boost::unordered_map<std::size_t /* readIdentifier */, Source /* position */> sources;
+	/** the number of observations of this kmer that aren't in sources */
+	std::size_t copies;
 	/** the total number of times that this kmer transitioned to a different base */
 	boost::unordered_map<char /* transition */, std::size_t /* transitionCount */> transitions;
 };
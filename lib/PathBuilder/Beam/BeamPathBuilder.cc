@@ -0,0 +1,156 @@
+/*
+ * File:   BeamPathBuilder.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BEAM_PATH_BUILDER_CC
+#define BEAM_PATH_BUILDER_CC
+
+#include <algorithm>
+#include <cmath>
+#include <boost/foreach.hpp>
+
+#include "PathBuilder/Beam/BeamPathBuilder.hh"
+
+DECLARE_LOG(logger, "qassembler.BeamPathBuilder");
+
+/**
+ * Order candidates by decreasing score, breaking ties by the order they were created in.
+ */
+class CompareCandidates {
+public:
+	CompareCandidates(const std::vector<double> &scores) : scores(scores) {}
+	bool operator()(std::size_t a, std::size_t b) const {
+		return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+	}
+private:
+	const std::vector<double> &scores;
+};
+
+BeamPathBuilder::BeamPathBuilder(boost::shared_ptr<SkinnyGraph> graph, std::size_t beamWidth) :
+		PathBuilder(graph), beamWidth(std::max<std::size_t>(beamWidth, 1)) {}
+
+boost::unordered_set<PathBuilder::Path>
+BeamPathBuilder::buildPaths() {
+	boost::unordered_set<PathBuilder::Path> paths;
+	boost::shared_ptr<StrongComponents> components = getStrongComponents();
+	boost::shared_ptr<SkinnyGraph::Graph> g = this->graph->graph();
+	std::vector<std::size_t> beam, next;
+	std::vector<double> candidateScores;
+	std::vector<SkinnyGraph::Vertex> startingPoints = getStartingPoints();
+	double startSum = 0.;
+	std::size_t steps = 0, completed = 0;
+
+	this->candidates.clear();
+	this->scores.clear();
+
+	// the probability of starting at a vertex is the number of times its first k-mer was seen
+	// compared to the first k-mers of all of the starting points in this graph.
+	BOOST_FOREACH (SkinnyGraph::Vertex v, startingPoints) {
+		startSum += this->graph->node(v)->getKmer(0)->getCount();
+	}
+	BOOST_FOREACH (SkinnyGraph::Vertex v, startingPoints) {
+		Candidate c;
+		c.vertex = components->vertexIndex(v);
+		c.parent = this->candidates.size();
+		c.score = log(this->graph->node(v)->getKmer(0)->getCount() / startSum);
+		beam.push_back(this->candidates.size());
+		this->candidates.push_back(c);
+	}
+
+	while (!beam.empty() && withinBudget(paths.size())) {
+		next.clear();
+		BOOST_FOREACH (std::size_t current, beam) {
+			std::size_t vertex = this->candidates[current].vertex;
+			SkinnyGraph::Vertex v = components->vertex(vertex);
+			double sum = 0.;
+			bool extended = false;
+
+			BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
+				sum += this->graph->edge(e)->getWeight();
+			}
+
+			BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
+				std::size_t target = components->vertexIndex(boost::target(e, *g));
+				// only vertices in a cyclic component can already be on the path.
+				if (components->cyclic(components->component(target)) && visits(current, target)) {
+					continue;
+				}
+
+				Candidate c;
+				c.vertex = target;
+				c.parent = current;
+				c.score = this->candidates[current].score + log(this->graph->edge(e)->getWeight() / sum);
+				next.push_back(this->candidates.size());
+				this->candidates.push_back(c);
+				extended = true;
+			}
+
+			if (!extended) {
+				if (!withinBudget(paths.size())) {
+					// stop searching once no more paths can be reported.
+					next.clear();
+					break;
+				}
+				PathBuilder::Path p = toPath(current);
+				if (paths.insert(p).second) {
+					this->scores[p] = this->candidates[current].score;
+				}
+				completed++;
+			}
+		}
+
+		// keep the best partial paths.
+		if (next.size() > this->beamWidth) {
+			candidateScores.resize(this->candidates.size());
+			BOOST_FOREACH (std::size_t c, next) {
+				candidateScores[c] = this->candidates[c].score;
+			}
+			std::partial_sort(next.begin(), next.begin() + this->beamWidth, next.end(), CompareCandidates(candidateScores));
+			next.resize(this->beamWidth);
+		}
+		beam.swap(next);
+		steps++;
+	}
+	DEBUG(logger, "Beam search of graph [" << this->graph->getId() << "] took [" << steps << "] steps, created ["
+	      << this->candidates.size() << "] partial paths and completed [" << completed << "] paths.");
+
+	return paths;
+}
+
+boost::unordered_map<PathBuilder::Path, double>
+BeamPathBuilder::getPathScores() {
+	return this->scores;
+}
+
+bool
+BeamPathBuilder::visits(std::size_t candidate, std::size_t vertex) {
+	while (true) {
+		if (this->candidates[candidate].vertex == vertex) {
+			return true;
+		} else if (this->candidates[candidate].parent == candidate) {
+			return false;
+		}
+		candidate = this->candidates[candidate].parent;
+	}
+}
+
+PathBuilder::Path
+BeamPathBuilder::toPath(std::size_t candidate) {
+	boost::shared_ptr<StrongComponents> components = getStrongComponents();
+	std::vector<SkinnyGraph::Vertex> vertices;
+
+	while (true) {
+		vertices.push_back(components->vertex(this->candidates[candidate].vertex));
+		if (this->candidates[candidate].parent == candidate) {
+			break;
+		}
+		candidate = this->candidates[candidate].parent;
+	}
+	std::reverse(vertices.begin(), vertices.end());
+
+	return verticesToSequenceNodes(vertices);
+}
+
+#endif // BEAM_PATH_BUILDER_CC
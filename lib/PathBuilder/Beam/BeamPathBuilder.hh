@@ -0,0 +1,77 @@
+/*
+ * File:   BeamPathBuilder.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BEAM_PATH_BUILDER_HH
+#define BEAM_PATH_BUILDER_HH
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+
+#include "PathBuilder/PathBuilder.hh"
+#include "Logging/Logging.hh"
+
+class BeamPathBuilder: public PathBuilder {
+public:
+	/**
+	 * Constructor.
+	 * @param graph the graph to use to construct paths
+	 * @param beamWidth the number of partial paths to keep at each step
+	 */
+	BeamPathBuilder(boost::shared_ptr<SkinnyGraph> graph, std::size_t beamWidth);
+
+	/**
+	 * Construct paths from the supplied graph with a beam search. All starting points are
+	 * extended together one edge at a time, and only the beamWidth partial paths with the
+	 * highest (log) probability are kept after each step. A partial path is complete when it
+	 * reaches a vertex that it can't leave without repeating a vertex. At most beamWidth
+	 * paths are extended at each step, so the search takes O(beamWidth * E) time.
+	 * @return the complete paths found by the search.
+	 */
+	boost::unordered_set<PathBuilder::Path> buildPaths();
+
+	/**
+	 * Get the (log) probability of each path found by the most recent call to buildPaths.
+	 * @return the log probability of each path.
+	 */
+	boost::unordered_map<PathBuilder::Path, double> getPathScores();
+private:
+	/**
+	 * A partial path in the search. Partial paths share their prefixes: each partial
+	 * path refers to the partial path that it extends.
+	 */
+	struct Candidate {
+		/** the last vertex on the partial path (dense identifier) */
+		std::size_t vertex;
+		/** the partial path that this extends (or itself, if this is a starting point) */
+		std::size_t parent;
+		/** the log probability of the partial path */
+		double score;
+	};
+
+	/** the number of partial paths to keep at each step */
+	std::size_t beamWidth;
+	/** the log probability of each path */
+	boost::unordered_map<PathBuilder::Path, double> scores;
+	/** all of the partial paths created by the search */
+	std::vector<Candidate> candidates;
+
+	/**
+	 * Does a partial path already visit a vertex?
+	 * @param candidate the partial path
+	 * @param vertex the vertex (dense identifier)
+	 * @return true if the vertex is on the partial path.
+	 */
+	bool visits(std::size_t candidate, std::size_t vertex);
+
+	/**
+	 * Convert a partial path into a path.
+	 * @param candidate the partial path
+	 * @return the sequence nodes on the path, in order.
+	 */
+	PathBuilder::Path toPath(std::size_t candidate);
+};
+
+#endif // BEAM_PATH_BUILDER_HH
@@ -0,0 +1,178 @@
+/*
+ * File:   FlowPathBuilder.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef FLOW_PATH_BUILDER_CC
+#define FLOW_PATH_BUILDER_CC
+
+#include <algorithm>
+#include <queue>
+#include <boost/foreach.hpp>
+
+#include "PathBuilder/Flow/FlowPathBuilder.hh"
+
+// the width of the path to a starting point.
+#define UNBOUNDED_WIDTH ((std::size_t) -1)
+// marks a vertex that hasn't been reached by a path.
+#define NO_EDGE ((std::size_t) -1)
+
+DECLARE_LOG(logger, "qassembler.FlowPathBuilder");
+
+FlowPathBuilder::FlowPathBuilder(boost::shared_ptr<SkinnyGraph> graph) : PathBuilder(graph) {}
+
+boost::unordered_set<PathBuilder::Path>
+FlowPathBuilder::buildPaths() {
+	boost::unordered_set<PathBuilder::Path> paths;
+	boost::shared_ptr<StrongComponents> components = getStrongComponents();
+	std::vector<std::size_t> sources, path, edges;
+	std::size_t rounds = 0;
+
+	snapshot();
+	this->flows.clear();
+
+	BOOST_FOREACH (SkinnyGraph::Vertex v, getStartingPoints()) {
+		std::size_t source = components->vertexIndex(v);
+		if (this->liveOut[source] == 0) {
+			// a vertex with no edges at all is a path by itself; use the number of times the
+			// first k-mer was seen as its flow.
+			PathBuilder::Path single(1, this->graph->node(v));
+			if (!withinBudget(paths.size())) {
+				break;
+			}
+			this->flows[single] += this->graph->node(v)->getKmer(0)->getCount();
+			paths.insert(single);
+		} else {
+			sources.push_back(source);
+		}
+	}
+
+	while (std::size_t width = widestPath(sources, path, edges)) {
+		std::vector<SkinnyGraph::Vertex> vertices;
+
+		if (!withinBudget(paths.size())) {
+			break;
+		}
+
+		BOOST_FOREACH (std::size_t e, edges) {
+			this->residual[e] -= width;
+			if (this->residual[e] == 0) {
+				std::size_t source = std::upper_bound(this->edgeOffsets.begin(), this->edgeOffsets.end(), e) - this->edgeOffsets.begin() - 1;
+				this->liveOut[source]--;
+			}
+		}
+
+		vertices.reserve(path.size());
+		BOOST_FOREACH (std::size_t v, path) {
+			vertices.push_back(components->vertex(v));
+		}
+		PathBuilder::Path p = verticesToSequenceNodes(vertices);
+		this->flows[p] += width;
+		paths.insert(p);
+		rounds++;
+		TRACE(logger, "Found path with [" << path.size() << "] vertices and flow [" << width << "].");
+	}
+	DEBUG(logger, "Decomposed graph [" << this->graph->getId() << "] into [" << paths.size() << "] paths in [" << rounds << "] rounds.");
+
+	return paths;
+}
+
+boost::unordered_map<PathBuilder::Path, std::size_t>
+FlowPathBuilder::getPathFlows() {
+	return this->flows;
+}
+
+void
+FlowPathBuilder::snapshot() {
+	boost::shared_ptr<StrongComponents> components = getStrongComponents();
+	boost::shared_ptr<SkinnyGraph::Graph> g = this->graph->graph();
+
+	this->edgeOffsets.clear();
+	this->edgeTargets.clear();
+	this->residual.clear();
+	this->liveOut.assign(components->numVertices(), 0);
+
+	for (std::size_t i = 0; i < components->numVertices(); i++) {
+		this->edgeOffsets.push_back(this->edgeTargets.size());
+		BOOST_FOREACH (SkinnyGraph::Edge e, boost::out_edges(components->vertex(i), *g)) {
+			std::size_t weight = this->graph->edge(e)->getWeight();
+			this->edgeTargets.push_back(components->vertexIndex(boost::target(e, *g)));
+			this->residual.push_back(weight);
+			if (weight > 0) {
+				this->liveOut[i]++;
+			}
+		}
+	}
+	this->edgeOffsets.push_back(this->edgeTargets.size());
+}
+
+std::size_t
+FlowPathBuilder::widestPath(const std::vector<std::size_t> &sources, std::vector<std::size_t> &path, std::vector<std::size_t> &edges) {
+	std::size_t numVertices = this->liveOut.size();
+	std::priority_queue<std::pair<std::size_t, std::size_t> > queue;
+
+	// the buffers are kept between calls so they're only allocated once per graph.
+	this->width.assign(numVertices, 0);
+	this->predecessor.assign(numVertices, NO_EDGE);
+	this->predecessorVertex.assign(numVertices, 0);
+	this->done.assign(numVertices, false);
+	path.clear();
+	edges.clear();
+
+	BOOST_FOREACH (std::size_t s, sources) {
+		width[s] = UNBOUNDED_WIDTH;
+		queue.push(std::make_pair(UNBOUNDED_WIDTH, s));
+	}
+
+	// a variant of dijkstra's algorithm where the length of a path is the weight of its smallest edge.
+	while (!queue.empty()) {
+		std::size_t v = queue.top().second;
+		queue.pop();
+		if (done[v]) {
+			continue;
+		}
+		done[v] = true;
+
+		for (std::size_t e = this->edgeOffsets[v]; e < this->edgeOffsets[v + 1]; e++) {
+			std::size_t t = this->edgeTargets[e];
+			std::size_t w = std::min(width[v], this->residual[e]);
+			if (w > width[t] && !done[t]) {
+				width[t] = w;
+				predecessor[t] = e;
+				predecessorVertex[t] = v;
+				queue.push(std::make_pair(w, t));
+			}
+		}
+	}
+
+	// prefer paths that end at a vertex with nothing left leaving it.
+	std::size_t end = NO_EDGE;
+	bool endIsSink = false;
+	for (std::size_t v = 0; v < numVertices; v++) {
+		if (predecessor[v] == NO_EDGE) {
+			continue;
+		}
+		bool sink = this->liveOut[v] == 0;
+		if (end == NO_EDGE || (sink && !endIsSink) || (sink == endIsSink && width[v] > width[end])) {
+			end = v;
+			endIsSink = sink;
+		}
+	}
+
+	if (end == NO_EDGE) {
+		return 0;
+	}
+
+	for (std::size_t v = end; predecessor[v] != NO_EDGE; v = predecessorVertex[v]) {
+		path.push_back(v);
+		edges.push_back(predecessor[v]);
+	}
+	path.push_back(predecessorVertex[path.back()]);
+	std::reverse(path.begin(), path.end());
+	std::reverse(edges.begin(), edges.end());
+
+	return width[end];
+}
+
+#endif // FLOW_PATH_BUILDER_CC
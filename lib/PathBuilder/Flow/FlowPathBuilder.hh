@@ -0,0 +1,77 @@
+/*
+ * File:   FlowPathBuilder.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef FLOW_PATH_BUILDER_HH
+#define FLOW_PATH_BUILDER_HH
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+
+#include "PathBuilder/PathBuilder.hh"
+#include "Logging/Logging.hh"
+
+class FlowPathBuilder: public PathBuilder {
+public:
+	/**
+	 * Constructor.
+	 * @param graph the graph to use to construct paths
+	 */
+	FlowPathBuilder(boost::shared_ptr<SkinnyGraph> graph);
+
+	/**
+	 * Construct paths from the supplied graph by decomposing the edge weights into flows.
+	 * The widest path (the path whose smallest edge weight is largest) from any starting
+	 * point is found and its width is subtracted from each of its edges, until no edge
+	 * has any weight left. Each round removes at least one edge, so there are at most as
+	 * many rounds as edges. Edge weights in the graph are not modified.
+	 * @return the paths that the edge weights were decomposed into.
+	 */
+	boost::unordered_set<PathBuilder::Path> buildPaths();
+
+	/**
+	 * Get the flow assigned to each path by the most recent call to buildPaths.
+	 * @return the flow (width) of each path.
+	 */
+	boost::unordered_map<PathBuilder::Path, std::size_t> getPathFlows();
+private:
+	/** the flow assigned to each path */
+	boost::unordered_map<PathBuilder::Path, std::size_t> flows;
+
+	/** the position in edgeTargets of the first edge leaving each vertex (one extra entry marks the end) */
+	std::vector<std::size_t> edgeOffsets;
+	/** the dense identifier of the target of each edge */
+	std::vector<std::size_t> edgeTargets;
+	/** the weight left on each edge */
+	std::vector<std::size_t> residual;
+	/** the number of edges with weight left leaving each vertex */
+	std::vector<std::size_t> liveOut;
+
+	/** the width of the widest path found to each vertex (reused by each call to widestPath) */
+	std::vector<std::size_t> width;
+	/** the edge that the widest path to each vertex arrives on */
+	std::vector<std::size_t> predecessor;
+	/** the vertex that the widest path to each vertex arrives from */
+	std::vector<std::size_t> predecessorVertex;
+	/** has the widest path to each vertex been found? */
+	std::vector<bool> done;
+
+	/**
+	 * Copy the edges of the graph and their weights into flat arrays.
+	 */
+	void snapshot();
+
+	/**
+	 * Find the widest path from any of the sources to a vertex with no edges left leaving it
+	 * (or, if a cycle prevents reaching such a vertex, to the vertex reachable with the widest path).
+	 * @param sources the dense identifiers of the vertices to start from
+	 * @param path the dense identifiers of the vertices on the path (filled by this method)
+	 * @param edges the edges on the path (filled by this method)
+	 * @return the width of the path, or 0 if no edge with weight left can be reached.
+	 */
+	std::size_t widestPath(const std::vector<std::size_t> &sources, std::vector<std::size_t> &path, std::vector<std::size_t> &edges);
+};
+
+#endif // FLOW_PATH_BUILDER_HH
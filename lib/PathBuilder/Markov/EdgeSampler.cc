@@ -0,0 +1,109 @@
+/*
+ * File:   EdgeSampler.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef EDGE_SAMPLER_CC
+#define EDGE_SAMPLER_CC
+
+#include <boost/foreach.hpp>
+
+#include "PathBuilder/Markov/EdgeSampler.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+DECLARE_LOG(logger, "qassembler.EdgeSampler");
+
+EdgeSampler::EdgeSampler(boost::shared_ptr<SkinnyGraph> graph) : graph(graph) {}
+
+const EdgeSampler::Table &
+EdgeSampler::table(SkinnyGraph::Vertex v) {
+	boost::unordered_map<SkinnyGraph::Vertex, Table>::iterator it = this->tables.find(v);
+
+	if (it == this->tables.end()) {
+		it = this->tables.insert(std::make_pair(v, Table())).first;
+		build(v, it->second);
+	}
+
+	return it->second;
+}
+
+bool
+EdgeSampler::cached(SkinnyGraph::Vertex v) const {
+	return this->tables.find(v) != this->tables.end();
+}
+
+SkinnyGraph::Edge
+EdgeSampler::sample(SkinnyGraph::Vertex v, double u) {
+	const Table &t = table(v);
+
+	if (t.total == 0) {
+		throw InvalidGraphStateException("Cannot sample an edge from a vertex with no outgoing edges.");
+	}
+
+	std::size_t target = (std::size_t) (u * t.total);
+	if (target >= t.total) {
+		target = t.total - 1;
+	}
+
+	// descend the tree to the first edge whose cumulative weight is larger than target.
+	std::size_t n = t.edges.size();
+	std::size_t step = 1;
+	while (step * 2 <= n) {
+		step *= 2;
+	}
+	std::size_t selected = 0;
+	for (; step > 0; step /= 2) {
+		if (selected + step <= n && t.tree[selected + step] <= target) {
+			selected += step;
+			target -= t.tree[selected];
+		}
+	}
+	TRACE(logger, "Random number [" << u << "] selected edge [" << selected << "] of [" << n << "]");
+
+	return t.edges[selected];
+}
+
+void
+EdgeSampler::update(SkinnyGraph::Edge e) {
+	boost::unordered_map<SkinnyGraph::Vertex, Table>::iterator it = this->tables.find(boost::source(e, *this->graph->graph()));
+
+	if (it == this->tables.end()) {
+		return;
+	}
+
+	Table &t = it->second;
+	for (std::size_t i = 0; i < t.edges.size(); i++) {
+		if (t.edges[i] == e) {
+			patch(t, i, this->graph->edge(e)->getWeight());
+			return;
+		}
+	}
+}
+
+void
+EdgeSampler::build(SkinnyGraph::Vertex v, Table &t) {
+	BOOST_FOREACH (SkinnyGraph::Edge e, boost::adaptors::filter(boost::out_edges(v, *this->graph->graph()), LiveEdge(this->graph))) {
+		t.edges.push_back(e);
+	}
+
+	t.weights.assign(t.edges.size(), 0);
+	t.tree.assign(t.edges.size() + 1, 0);
+	for (std::size_t i = 0; i < t.edges.size(); i++) {
+		patch(t, i, this->graph->edge(t.edges[i])->getWeight());
+	}
+}
+
+void
+EdgeSampler::patch(Table &t, std::size_t i, std::size_t weight) {
+	std::size_t old = t.weights[i];
+	t.weights[i] = weight;
+	t.total = t.total - old + weight;
+
+	// the sums are unsigned, so subtract the old weight before adding the new one to each.
+	for (std::size_t j = i + 1; j < t.tree.size(); j += j & (~j + 1)) {
+		t.tree[j] = t.tree[j] - old + weight;
+	}
+}
+
+#endif // EDGE_SAMPLER_CC
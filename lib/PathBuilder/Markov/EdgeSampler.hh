@@ -0,0 +1,97 @@
+/*
+ * File:   EdgeSampler.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef EDGE_SAMPLER_HH
+#define EDGE_SAMPLER_HH
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "PathBuilder/PathBuilder.hh"
+#include "Logging/Logging.hh"
+
+/**
+ * Select edges leaving a vertex with probability proportional to their weight. The
+ * distribution for a vertex is built the first time an edge is sampled from it, and is kept
+ * for as long as the sampler lives: when the weight of an edge changes, only the entry for
+ * that edge is patched, so the table is never rebuilt.
+ */
+class EdgeSampler {
+public:
+	/**
+	 * The distribution of the edges leaving a vertex, kept as a Fenwick tree over the edge
+	 * weights so that both patching a weight and drawing an edge take O(log d) steps.
+	 */
+	struct Table {
+		Table() : total(0) {}
+		/** the edges that were live when the table was built, in out-edge order */
+		std::vector<SkinnyGraph::Edge> edges;
+		/** the weight of each edge, as last seen by the sampler */
+		std::vector<std::size_t> weights;
+		/** the Fenwick tree over weights (1-based, tree[0] is unused) */
+		std::vector<std::size_t> tree;
+		/** the sum of the weights */
+		std::size_t total;
+	};
+
+	/**
+	 * Constructor.
+	 * @param graph the graph to sample edges from
+	 */
+	EdgeSampler(boost::shared_ptr<SkinnyGraph> graph);
+
+	/**
+	 * Get the distribution of the edges leaving a vertex, building it if necessary.
+	 * @param v the vertex in question
+	 * @return the distribution of the edges leaving v
+	 */
+	const Table &table(SkinnyGraph::Vertex v);
+
+	/**
+	 * Has the distribution for a vertex been built?
+	 * @param v the vertex in question
+	 * @return true if a table is kept for v
+	 */
+	bool cached(SkinnyGraph::Vertex v) const;
+
+	/**
+	 * Select an edge leaving a vertex.
+	 * @param v the vertex in question (must have at least one live outgoing edge)
+	 * @param u a uniform random number in [0, 1)
+	 * @return the edge whose share of the cumulative weight contains u
+	 */
+	SkinnyGraph::Edge sample(SkinnyGraph::Vertex v, double u);
+
+	/**
+	 * Patch the distribution of the source of an edge after the weight of the edge has
+	 * changed. Nothing is done if no table has been built for the source.
+	 * @param e the edge whose weight changed
+	 */
+	void update(SkinnyGraph::Edge e);
+private:
+	/** the graph that edges are sampled from */
+	boost::shared_ptr<SkinnyGraph> graph;
+	/** the distributions that have been built so far */
+	boost::unordered_map<SkinnyGraph::Vertex, Table> tables;
+
+	/**
+	 * Build the distribution of the live edges leaving a vertex.
+	 * @param v the vertex in question
+	 * @param t the table to fill
+	 */
+	void build(SkinnyGraph::Vertex v, Table &t);
+
+	/**
+	 * Change the weight of one entry in a table.
+	 * @param t the table to patch
+	 * @param i the position of the edge in the table
+	 * @param weight the new weight of the edge
+	 */
+	void patch(Table &t, std::size_t i, std::size_t weight);
+};
+
+#endif // EDGE_SAMPLER_HH
@@ -8,7 +8,6 @@
 #ifndef MARKOV_PATH_BUILDER_CC
 #define MARKOV_PATH_BUILDER_CC
 
-#include <algorithm>
 #include <vector>
 #include <boost/foreach.hpp>
 #include "PathBuilder/Markov/MarkovPathBuilder.hh"
@@ -23,9 +22,10 @@ MarkovPathBuilder::buildPaths() {
 	boost::unordered_set<PathBuilder::Path> paths;
 	std::vector<SkinnyGraph::Vertex> startingPoints = getStartingPoints();
 	boost::shared_ptr<SkinnyGraph::Graph> g = this->graph->graph();
+	EdgeSampler sampler(this->graph);
 
 	TRACE(logger, "Generating paths.");
-	while (!startingPoints.empty()) {
+	while (!startingPoints.empty() && withinBudget(paths.size())) {
 		std::vector<SkinnyGraph::Edge> edgesFollowed;
 		std::vector<SkinnyGraph::Vertex> verticesFollowed;
 		SkinnyGraph::Vertex v = startingPoints.front();
@@ -33,58 +33,40 @@ MarkovPathBuilder::buildPaths() {
 		std::size_t smallestEdge = (std::size_t) -1;
 
 		verticesFollowed.push_back(v);
+		markVisited(v);
 
-		if (getOutgoingEdges(v).size() == 0) {
+		if (outDegree(v) == 0) {
 			startingPoints.erase(startingPoints.begin());
 		} else {
-			while (getOutgoingEdges(v).size() > 0) {
+			while (outDegree(v) > 0) {
 				std::string vertexName = this->graph->node(v)->getName();
 				// if the vertex has only one outgoing edge, then follow it:
 				TRACE(logger, "Vertex [" << vertexName << "].");
-				if (getOutgoingEdges(v).size() == 1) {
+				if (outDegree(v) == 1) {
 					TRACE(logger, "Vertex [" << vertexName << "] has one outgoing edge, following that edge.");
-					SkinnyGraph::OutgoingEdges edges;
-					boost::tie(edges, boost::tuples::ignore) = boost::out_edges(v, *g);
-					v = boost::target(*edges, *g);
-					e = *edges;
+					e = *boost::begin(getOutgoingEdges(v));
+					v = boost::target(e, *g);
 				} else {
 					TRACE(logger, "Vertex [" << vertexName << "] has multiple outgoing edges, picking edge.");
 					// the vertex has multiple outgoing edges. going to select an edge by markov process:
-					// first get the sum of weights of outgoing edges:
-					double sum = sumOutgoingEdges(v);
-					// create a list of all outgoing edges and their respective weights
-					std::vector<EdgeWeightPair> outgoingEdges;
-					TRACE(logger, "Constructing list of outgoing edge weights.");
-					BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
-						outgoingEdges.push_back(std::make_pair(e, this->graph->edge(e)->getWeight() / sum));
-					}
-					TRACE(logger, "Sorting edge weights.");
-					std::sort(outgoingEdges.begin(), outgoingEdges.end(), compareEdgeWeightPairs);
 					// generate a random number:
 					TRACE(logger, "Generating random number.");
 					double markov = rng();
 					TRACE(logger, "Random number is [" << markov << "]");
-					// select an edge using the random number
-					SkinnyGraph::Edge selectedEdge;
-					bool selected = false;
-					double total = 0.;
-					TRACE(logger, "Selecting edge.");
-					BOOST_FOREACH (EdgeWeightPair ewp, outgoingEdges) {
-						TRACE(logger, "Testing [" << total << "] > [" << markov << "]");
-						total += ewp.second;
-						if (total > markov) {
-							selectedEdge = ewp.first;
-							selected = true;
-							break;
-						}
-					}
-					assert(selected);
+					// select an edge using the random number (the distribution of edges leaving v
+					// is kept across walks and patched as their weights are consumed):
+					SkinnyGraph::Edge selectedEdge = sampler.sample(v, markov);
 					TRACE(logger, "Selected edge: [" << std::hex << selectedEdge << std::dec << "]");
 					v = boost::target(selectedEdge, *g);
 					TRACE(logger, "Target: [" << this->graph->node(v)->getName() << "]");
 					e = selectedEdge;
 				}
 
+				if (!markVisited(v)) {
+					TRACE(logger, "Encountered cycle, breaking from path.");
+					break;
+				}
+
 				verticesFollowed.push_back(v);
 				edgesFollowed.push_back(e);
 
@@ -98,13 +80,17 @@ MarkovPathBuilder::buildPaths() {
 				}
 			}
 
+			// if every edge on the path has a weight of 1, then consume all of them:
+			if (smallestEdge == (std::size_t) -1) {
+				smallestEdge = 1;
+			}
+
 			bool allPositive = true;
 			TRACE(logger, "Reducing edge weights by [" << smallestEdge << "]");
 			BOOST_FOREACH (SkinnyGraph::Edge e, edgesFollowed) {
-				boost::shared_ptr<WeightedEdge> edge = this->graph->edge(e);
-				std::size_t weight = edge->getWeight() - smallestEdge;
-				edge->setWeight(weight);
-				allPositive &= !edge->removed();
+				decreaseEdgeWeight(e, smallestEdge);
+				sampler.update(e);
+				allPositive &= !this->graph->edge(e)->removed();
 			}
 
 			if (!allPositive) {
@@ -113,6 +99,7 @@ MarkovPathBuilder::buildPaths() {
 			}
 		}
 
+		clearVisited(verticesFollowed);
 		PathBuilder::Path path = verticesToSequenceNodes(verticesFollowed);
 		paths.insert(path);
 
@@ -122,20 +109,4 @@ MarkovPathBuilder::buildPaths() {
 	return paths;
 }
 
-double
-MarkovPathBuilder::sumOutgoingEdges(SkinnyGraph::Vertex v) {
-	double sum = 0;
-
-	BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
-		sum += this->graph->edge(e)->getWeight();
-	}
-
-	return sum;
-}
-
-bool
-compareEdgeWeightPairs (EdgeWeightPair a, EdgeWeightPair b) {
-	return a.second < b.second;
-}
-
 #endif // MARKOV_PATH_BUILDER_CC
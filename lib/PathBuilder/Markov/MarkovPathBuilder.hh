@@ -9,6 +9,7 @@
 #define MARKOVPATHBUILDER_HH_
 
 #include "PathBuilder/PathBuilder.hh"
+#include "PathBuilder/Markov/EdgeSampler.hh"
 #include "Logging/Logging.hh"
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/variate_generator.hpp>
@@ -29,24 +30,9 @@ public:
 	boost::unordered_set<PathBuilder::Path> buildPaths();
 private:
 
-	/**
-	 * Sum the weights of the edges incoming to a certain vertex
-	 * @param v the vertex in question
-	 */
-	double sumIncomingEdges(SkinnyGraph::Vertex v);
-
-	/**
-	 * Sum the weights of the edges leaving a certain vertex
-	 * @param v the vertex in question
-	 */
-	double sumOutgoingEdges(SkinnyGraph::Vertex v);
-
 	boost::uniform_real<> uniform_distribution;
 	boost::mt19937 generator;
 	boost::variate_generator<boost::mt19937&, boost::uniform_real<> > rng;
 };
 
-typedef std::pair<SkinnyGraph::Edge, double> EdgeWeightPair;
-bool compareEdgeWeightPairs(EdgeWeightPair a, EdgeWeightPair b);
-
 #endif /* MARKOVPATHBUILDER_HH_ */
@@ -8,14 +8,25 @@
 #define PATH_BUILDER_CC
 
 #include <boost/foreach.hpp>
+#include <boost/make_shared.hpp>
 #include <algorithm>
 
 #include "PathBuilder.hh"
 
 DECLARE_LOG(logger, "qassembler.PathBuilder");
 
-PathBuilder::PathBuilder(boost::shared_ptr<SkinnyGraph> graph) {
+LiveEdge::LiveEdge() : g(NULL) {}
+
+LiveEdge::LiveEdge(boost::shared_ptr<SkinnyGraph> graph) : g(graph->graph().get()) {}
+
+bool
+LiveEdge::operator()(const SkinnyGraph::Edge &e) const {
+	return !(*g)[e]->removed();
+}
+
+PathBuilder::PathBuilder(boost::shared_ptr<SkinnyGraph> graph) : budgetExhausted(false) {
 	this->graph = graph;
+	indexGraph();
 }
 
 PathBuilder::~PathBuilder() {
@@ -30,6 +41,31 @@ PathBuilder::getGraph() {
 void
 PathBuilder::setGraph(boost::shared_ptr<SkinnyGraph> graph) {
 	this->graph = graph;
+	indexGraph();
+}
+
+void
+PathBuilder::setBudget(boost::shared_ptr<Budget> budget) {
+	this->budget = budget;
+	this->budgetExhausted = false;
+}
+
+bool
+PathBuilder::truncated() {
+	return this->budgetExhausted;
+}
+
+bool
+PathBuilder::withinBudget(std::size_t paths) {
+	if (this->budget && !this->budget->allows(paths)) {
+		if (!this->budgetExhausted) {
+			DEBUG(logger, "Budget for graph [" << this->graph->getId() << "] ran out after [" << paths << "] paths.");
+		}
+		this->budgetExhausted = true;
+		return false;
+	}
+
+	return true;
 }
 
 std::vector<SkinnyGraph::Vertex>
@@ -57,32 +93,136 @@ PathBuilder::verticesToSequenceNodes(std::vector<SkinnyGraph::Vertex> vertices)
 	return p;
 }
 
-std::vector<SkinnyGraph::Edge>
+PathBuilder::LiveOutgoingEdges
 PathBuilder::getOutgoingEdges(SkinnyGraph::Vertex vertex) {
-	std::vector<SkinnyGraph::Edge> outgoingEdges;
+	return boost::adaptors::filter(boost::out_edges(vertex, *this->graph->graph()), LiveEdge(this->graph));
+}
 
-	BOOST_FOREACH (SkinnyGraph::Edge e, boost::out_edges(vertex, *this->graph->graph())) {
-		if (!this->graph->edge(e)->removed()) {
-			outgoingEdges.push_back(e);
+PathBuilder::LiveIncomingEdges
+PathBuilder::getIncomingEdges(SkinnyGraph::Vertex vertex) {
+	return boost::adaptors::filter(boost::in_edges(vertex, *this->graph->graph()), LiveEdge(this->graph));
+}
+
+std::size_t
+PathBuilder::outDegree(SkinnyGraph::Vertex vertex) {
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t>::iterator it = this->liveOutDegree.find(vertex);
+	return it == this->liveOutDegree.end() ? 0 : it->second;
+}
+
+std::size_t
+PathBuilder::inDegree(SkinnyGraph::Vertex vertex) {
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t>::iterator it = this->liveInDegree.find(vertex);
+	return it == this->liveInDegree.end() ? 0 : it->second;
+}
+
+const PathBuilder::EdgeChoice &
+PathBuilder::pickNextEdge(SkinnyGraph::Vertex vertex, double p, double epsilon) {
+	double maxWeight = 0;
+
+	// the collection is kept between calls so that its storage is reused.
+	this->choice.edges.clear();
+	this->choice.sum = 0;
+	this->choice.max = 0;
+	this->choice.closest = 0;
+	this->choice.found = false;
+
+	BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(vertex)) {
+		double weight = this->graph->edge(e)->getWeight();
+		if (weight > maxWeight) {
+			maxWeight = weight;
+			this->choice.max = this->choice.edges.size();
 		}
+		this->choice.sum += weight;
+		this->choice.edges.push_back(std::make_pair(e, weight));
 	}
 
-	return outgoingEdges;
+	// the proportions can only be computed once the sum is known, but there are at most
+	// a handful of edges leaving any vertex, so check the collected weights instead of the graph.
+	if (p >= 0) {
+		for (std::size_t i = 0; i < this->choice.edges.size(); i++) {
+			double edgeP = this->choice.edges[i].second / this->choice.sum;
+			if (edgeP > p - epsilon && edgeP < p + epsilon) {
+				this->choice.closest = i;
+				this->choice.found = true;
+				break;
+			}
+		}
+	}
+
+	return this->choice;
 }
 
-std::vector<SkinnyGraph::Edge>
-PathBuilder::getIncomingEdges(SkinnyGraph::Vertex vertex) {
-	std::vector<SkinnyGraph::Edge> incomingEdges;
+void
+PathBuilder::setEdgeWeight(SkinnyGraph::Edge e, std::size_t weight) {
+	boost::shared_ptr<WeightedEdge> edge = this->graph->edge(e);
+	bool wasRemoved = edge->removed();
+	edge->setWeight(weight);
+	updateLiveDegrees(e, wasRemoved);
+}
+
+void
+PathBuilder::decreaseEdgeWeight(SkinnyGraph::Edge e, std::size_t amount) {
+	boost::shared_ptr<WeightedEdge> edge = this->graph->edge(e);
+	bool wasRemoved = edge->removed();
+	edge->decreaseWeight(amount);
+	updateLiveDegrees(e, wasRemoved);
+}
+
+bool
+PathBuilder::markVisited(SkinnyGraph::Vertex vertex) {
+	std::size_t index = this->strongComponents->vertexIndex(vertex);
+
+	if (!this->strongComponents->cyclic(this->strongComponents->component(index))) {
+		return true;
+	} else if (this->visited[index]) {
+		return false;
+	}
+
+	this->visited[index] = true;
+	return true;
+}
 
-	BOOST_FOREACH (SkinnyGraph::Edge e, boost::in_edges(vertex, *this->graph->graph())) {
-		TRACE (logger, "Current edge weight: [" << this->graph->edge(e)->getWeight() << "]");
+void
+PathBuilder::clearVisited(const std::vector<SkinnyGraph::Vertex> &vertices) {
+	BOOST_FOREACH (SkinnyGraph::Vertex v, vertices) {
+		this->visited[this->strongComponents->vertexIndex(v)] = false;
+	}
+}
+
+boost::shared_ptr<StrongComponents>
+PathBuilder::getStrongComponents() {
+	return this->strongComponents;
+}
+
+void
+PathBuilder::indexGraph() {
+	this->strongComponents = boost::make_shared<StrongComponents>(this->graph);
+	this->visited.assign(this->strongComponents->numVertices(), false);
+	this->liveOutDegree.clear();
+	this->liveInDegree.clear();
+
+	BOOST_FOREACH (SkinnyGraph::Edge e, this->graph->edges()) {
 		if (!this->graph->edge(e)->removed()) {
-			TRACE (logger, "adding edge to collection");
-			incomingEdges.push_back(e);
+			this->liveOutDegree[boost::source(e, *this->graph->graph())]++;
+			this->liveInDegree[boost::target(e, *this->graph->graph())]++;
 		}
 	}
+}
 
-	return incomingEdges;
+void
+PathBuilder::updateLiveDegrees(SkinnyGraph::Edge e, bool wasRemoved) {
+	bool removed = this->graph->edge(e)->removed();
+	SkinnyGraph::Vertex source = boost::source(e, *this->graph->graph());
+	SkinnyGraph::Vertex target = boost::target(e, *this->graph->graph());
+
+	if (removed && !wasRemoved) {
+		TRACE(logger, "Edge [" << std::hex << e << std::dec << "] was consumed.");
+		this->liveOutDegree[source]--;
+		this->liveInDegree[target]--;
+	} else if (!removed && wasRemoved) {
+		this->liveOutDegree[source]++;
+		this->liveInDegree[target]++;
+	}
 }
 
 bool
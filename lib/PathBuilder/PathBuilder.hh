@@ -8,21 +8,64 @@
 #define PATH_BUILDER_HH
 
 #include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/range/adaptor/filtered.hpp>
 
 #include "Graph/SkinnyGraph.hh"
+#include "Graph/StrongComponents.hh"
 #include "Graph/Node/SequenceNode.hh"
+#include "Util/Budget.hh"
 #include "Logging/Logging.hh"
 
+typedef std::pair<SkinnyGraph::Edge, double> EdgeWeightPair;
+
+/**
+ * Predicate accepting edges that have not yet been completely consumed by path construction.
+ */
+class LiveEdge {
+public:
+	LiveEdge();
+	LiveEdge(boost::shared_ptr<SkinnyGraph> graph);
+	bool operator()(const SkinnyGraph::Edge &e) const;
+private:
+	SkinnyGraph::Graph *g;
+};
+
 class PathBuilder {
 public:
 	/** to be used as a way to describe a path through the graph */
 	typedef std::vector<boost::shared_ptr<SequenceNode> > Path;
+	/** a lazy range over the edges leaving a vertex that have not been consumed */
+	typedef boost::filtered_range<LiveEdge, const std::pair<SkinnyGraph::OutgoingEdges, SkinnyGraph::OutgoingEdges> > LiveOutgoingEdges;
+	/** a lazy range over the edges entering a vertex that have not been consumed */
+	typedef boost::filtered_range<LiveEdge, const std::pair<SkinnyGraph::IncomingEdges, SkinnyGraph::IncomingEdges> > LiveIncomingEdges;
+
+	/**
+	 * The live edges leaving a vertex, collected in a single pass so that a path builder
+	 * can decide which edge to follow without walking the edges again.
+	 */
+	struct EdgeChoice {
+		/** the live edges and their weights, in out-edge order */
+		std::vector<EdgeWeightPair> edges;
+		/** the sum of the weights of the live edges */
+		double sum;
+		/** the position in edges of the (first) edge with the largest weight */
+		std::size_t max;
+		/** the position in edges of the first edge with a proportion within epsilon of the requested proportion */
+		std::size_t closest;
+		/** was an edge within epsilon of the requested proportion found? */
+		bool found;
+	};
 
 	/** get the graph that this path builder uses to construct paths */
 	boost::shared_ptr<SkinnyGraph> getGraph();
 	/** set the graph that this path builder uses to construct paths */
 	void setGraph(boost::shared_ptr<SkinnyGraph> graph);
+	/** limit the number of paths and the time spent by the next call to buildPaths */
+	void setBudget(boost::shared_ptr<Budget> budget);
+	/** did the most recent call to buildPaths stop early because its budget ran out? */
+	bool truncated();
 
 	/** 
 	 * construct some set of paths from the graph.
@@ -54,22 +97,121 @@ protected:
 
 	/**
 	 * Get all edges outgoing from a vertex which have not yet been completely
-	 * consumed by previous path construction.
+	 * consumed by previous path construction. The edges are filtered lazily, so
+	 * no collection is allocated.
 	 * @param vertex the vertex to retrieve outgoing edges for.
-	 * @return the set of outgoing edges for that vertex.
+	 * @return the outgoing edges for that vertex.
 	 */
-	std::vector<SkinnyGraph::Edge> getOutgoingEdges(SkinnyGraph::Vertex vertex);
+	LiveOutgoingEdges getOutgoingEdges(SkinnyGraph::Vertex vertex);
 
 	/**
 	 * Get all edges incoming to a vertex which have not yet been completely
-	 * consumed by previous path construction.
+	 * consumed by previous path construction. The edges are filtered lazily, so
+	 * no collection is allocated.
 	 * @param vertex the vertex to retrieve incoming edges for.
-	 * @return the set of incoming edges for that vertex.
+	 * @return the incoming edges for that vertex.
+	 */
+	LiveIncomingEdges getIncomingEdges(SkinnyGraph::Vertex vertex);
+
+	/**
+	 * Count the edges leaving a vertex that have not been consumed.
+	 * @param vertex the vertex in question
+	 * @return the number of live outgoing edges
 	 */
-	std::vector<SkinnyGraph::Edge> getIncomingEdges(SkinnyGraph::Vertex vertex);
+	std::size_t outDegree(SkinnyGraph::Vertex vertex);
+
+	/**
+	 * Count the edges entering a vertex that have not been consumed.
+	 * @param vertex the vertex in question
+	 * @return the number of live incoming edges
+	 */
+	std::size_t inDegree(SkinnyGraph::Vertex vertex);
+
+	/**
+	 * Collect the live edges leaving a vertex with their sum, the edge with the largest
+	 * weight and the first edge with a proportion within epsilon of p in one pass over
+	 * the edges. The returned choice is reused by the next call.
+	 * @param vertex the vertex in question
+	 * @param p the proportion to look for (no edge is searched for if p is negative)
+	 * @param epsilon how close an edge's proportion must be to p
+	 * @return the live edges leaving the vertex
+	 */
+	const EdgeChoice &pickNextEdge(SkinnyGraph::Vertex vertex, double p, double epsilon);
+
+	/**
+	 * Set the weight of an edge, keeping the live degree counts up to date.
+	 * @param e the edge to modify
+	 * @param weight the new weight of the edge
+	 */
+	void setEdgeWeight(SkinnyGraph::Edge e, std::size_t weight);
+
+	/**
+	 * Decrease the weight of an edge, keeping the live degree counts up to date.
+	 * @param e the edge to modify
+	 * @param amount the amount to decrease the weight by
+	 */
+	void decreaseEdgeWeight(SkinnyGraph::Edge e, std::size_t amount);
+
+	/**
+	 * Mark a vertex as visited by the path that is currently being built. Vertices outside
+	 * of cyclic strong components can never be visited twice by the same path, so they
+	 * are not recorded.
+	 * @param vertex the vertex being visited
+	 * @return false if the current path has already visited the vertex (it has found a cycle).
+	 */
+	bool markVisited(SkinnyGraph::Vertex vertex);
+
+	/**
+	 * Forget the vertices visited by a path, so that the next path starts with none visited.
+	 * @param vertices the vertices visited by the path
+	 */
+	void clearVisited(const std::vector<SkinnyGraph::Vertex> &vertices);
+
+	/**
+	 * Get the strong components of the graph, computed when the graph was set.
+	 * @return the strong components of the graph.
+	 */
+	boost::shared_ptr<StrongComponents> getStrongComponents();
+
+	/**
+	 * Check whether the budget allows another path to be built. Implementations should check
+	 * before starting each path, and stop building paths (keeping the paths already built) when
+	 * the budget runs out.
+	 * @param paths the number of paths built so far
+	 * @return false (and mark the paths as truncated) if the budget has run out.
+	 */
+	bool withinBudget(std::size_t paths);
 
 	/** the graph that we'll search for paths in */
 	boost::shared_ptr<SkinnyGraph> graph;
+	/** the limit on paths built and time spent (no limit if null) */
+	boost::shared_ptr<Budget> budget;
+private:
+	/** did building paths stop early because the budget ran out? */
+	bool budgetExhausted;
+	/** the strong components of the graph */
+	boost::shared_ptr<StrongComponents> strongComponents;
+	/** the vertices visited by the current path, by dense vertex identifier */
+	std::vector<bool> visited;
+	/** the number of live edges leaving each vertex */
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t> liveOutDegree;
+	/** the number of live edges entering each vertex */
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t> liveInDegree;
+	/** the most recent choice returned by pickNextEdge */
+	EdgeChoice choice;
+
+	/**
+	 * Count the live edges entering and leaving each vertex in the graph, and find the strong
+	 * components of the graph.
+	 */
+	void indexGraph();
+
+	/**
+	 * Update the live degree counts of the endpoints of an edge that was consumed or restored.
+	 * @param e the edge that changed
+	 * @param wasRemoved was the edge removed before its weight was changed?
+	 */
+	void updateLiveDegrees(SkinnyGraph::Edge e, bool wasRemoved);
 };
 
 bool compareVertexIdentifiers(SkinnyGraph::Vertex v1, SkinnyGraph::Vertex v2);
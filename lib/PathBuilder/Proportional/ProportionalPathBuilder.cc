@@ -7,6 +7,7 @@
 #ifndef PROPORTIONAL_PATH_BUILDER_CC
 #define PROPORTIONAL_PATH_BUILDER_CC
 
+#include <algorithm>
 #include <boost/foreach.hpp>
 
 #include "PathBuilder/Proportional/ProportionalPathBuilder.hh"
@@ -19,12 +20,23 @@ ProportionalPathBuilder::ProportionalPathBuilder(boost::shared_ptr<SkinnyGraph>
 
 boost::unordered_set<PathBuilder::Path>
 ProportionalPathBuilder::buildPaths() {
+	// most graphs are acyclic once erroneous edges have been removed, and paths through those
+	// can be built without looking up edges and vertices in the graph.
+	if (getStrongComponents()->acyclic()) {
+		return buildAcyclicPaths();
+	} else {
+		return buildCyclicPaths();
+	}
+}
+
+boost::unordered_set<PathBuilder::Path>
+ProportionalPathBuilder::buildCyclicPaths() {
 	boost::unordered_set<PathBuilder::Path> paths;
 	std::vector<SkinnyGraph::Vertex> startingPoints = getStartingPoints();
 	boost::shared_ptr<SkinnyGraph::Graph> g = this->graph->graph();
 
 
-	while (!startingPoints.empty()) {
+	while (!startingPoints.empty() && withinBudget(paths.size())) {
 		// we haven't yet selected a proportion, start with a sentinel value of -1
 		double p = -1.;
 		std::vector<SkinnyGraph::Edge> followed;
@@ -40,41 +52,43 @@ ProportionalPathBuilder::buildPaths() {
 		// keep track of all of the vertices we've already covered, including the
 		// starting point
 		verticesFollowed.push_back(v);
+		markVisited(v);
 
 		// for each starting point, we're going to continually follow a path until we
 		// arrive at a node that has no more outgoing edges. When a node has no outgoing
 		// edges, then we've reached the end of the possible path that we're searching.
-		while (getOutgoingEdges(v).size() > 0) {
+		while (outDegree(v) > 0) {
 			std::string vertexName = this->graph->node(v)->getName();
 			TRACE(logger, "This node has outgoing edges, going to pick which edge to follow.");
 			double sum = 0;
 			// if v has more than one incoming edge and we haven't yet selected a proportion, then we should
 			// select a proportion based upon the weight of the edges incoming to this node and the edge we took
 			// to get here.
-			if (getIncomingEdges(v).size() > 1 && p < 0) {
-				TRACE(logger, "Vertex " << vertexName << " has more than one incoming edge [" << getIncomingEdges(v).size() << "], but we haven't selected a proportion. Defining proportion.");
+			if (inDegree(v) > 1 && p < 0) {
+				TRACE(logger, "Vertex " << vertexName << " has more than one incoming edge [" << inDegree(v) << "], but we haven't selected a proportion. Defining proportion.");
 				sum = sumIncomingEdges(v);
 				boost::shared_ptr<WeightedEdge> e = this->graph->edge(lastEdge);
 				p = e->getWeight() / sum;
 				TRACE(logger, "Selected proportion: [" << p << "].");
 			}
 
+			// collect the sum, the largest edge and the edge closest to p in one pass.
+			const EdgeChoice &choice = pickNextEdge(v, p, this->epsilon);
+
 			// if v only has one outgoing edge, then we only have one possible edge to take, so take
 			// that edge.
-			if (getOutgoingEdges(v).size() == 1) {
+			if (choice.edges.size() == 1) {
 				TRACE(logger, "Vertex " << vertexName << " only has one outgoing edge, following that edge.");
-				SkinnyGraph::OutgoingEdges e;
-				boost::tie(e, boost::tuples::ignore) = boost::out_edges(v, *g);
-				v = boost::target(*e, *g);
-				lastEdge = *e;
+				lastEdge = choice.edges.front().first;
+				v = boost::target(lastEdge, *g);
 			} else {
 				TRACE(logger, "Vertex " << vertexName << " has more than one outgoing edge, going to decide which to use.");
 				// v doesn't have only one outgoing edge. We're going to start by finding the edge with
 				// the largest outgoing weight to see if that's pretty close to the proportion we previously
 				// selected.
-				SkinnyGraph::Edge maxEdge; std::size_t maxWeight;
-				boost::tie(maxEdge, maxWeight) = findMaxEdge(v);
-				sum = sumOutgoingEdges(v);
+				SkinnyGraph::Edge maxEdge = choice.edges[choice.max].first;
+				std::size_t maxWeight = choice.edges[choice.max].second;
+				sum = choice.sum;
 
 				if (p < 0) {
 					TRACE(logger, "We haven't selected a proportion yet, so we're just going to pick the edge with the largest weight.");
@@ -89,10 +103,8 @@ ProportionalPathBuilder::buildPaths() {
 					TRACE(logger, "We've already selected a proportion, going to try finding a similar edge.");
 					// we've already selected a proportion. Try to find an edge exiting this node that
 					// has a proportion similar to what we selected already.
-					SkinnyGraph::Edge closest; bool found;
-					boost::tie(closest, found) = findClosestEdge(v, p);
-
-					if (found) {
+					if (choice.found) {
+						SkinnyGraph::Edge closest = choice.edges[choice.closest].first;
 						// we found a proportion similar to the one we'd defined already,
 						// we don't need to modify the proportion we've selected, just follow
 						// that edge to the next node.
@@ -122,7 +134,7 @@ ProportionalPathBuilder::buildPaths() {
 				}
 			}
 
-			if (std::find(verticesFollowed.begin(), verticesFollowed.end(), v) != verticesFollowed.end()) {
+			if (!markVisited(v)) {
 				TRACE(logger, "Encountered cycle, breaking from path.");
 				break;
 			}
@@ -149,9 +161,11 @@ ProportionalPathBuilder::buildPaths() {
 		TRACE(logger, "Finished creating path in graph [" << this->graph->getId() << "]. Final sequence is [" << constructed << "] which is [" << constructed.size() << "] characters long. Followed [" << followed.size() << "] edges, smallest edge was: [" << smallestEdge << "]");
 
 		BOOST_FOREACH (SkinnyGraph::Edge e, followed) {
-			this->graph->edge(e)->decreaseWeight(smallestEdge);
+			decreaseEdgeWeight(e, smallestEdge);
 		}
 
+		clearVisited(verticesFollowed);
+
 		// keep track of the paths that we've followed
 		path = verticesToSequenceNodes(verticesFollowed);
 		paths.insert(path);
@@ -166,73 +180,164 @@ ProportionalPathBuilder::buildPaths() {
 	return paths;
 }
 
-double
-ProportionalPathBuilder::getEpsilon() {
-	return this->epsilon;
-}
-
-void
-ProportionalPathBuilder::setEpsilon(double epsilon) {
-	this->epsilon = epsilon;
-}
+boost::unordered_set<PathBuilder::Path>
+ProportionalPathBuilder::buildAcyclicPaths() {
+	boost::unordered_set<PathBuilder::Path> paths;
+	boost::shared_ptr<StrongComponents> components = getStrongComponents();
+	boost::shared_ptr<SkinnyGraph::Graph> g = this->graph->graph();
+	std::size_t numVertices = components->numVertices();
+	std::vector<std::size_t> order, position(numVertices);
+	std::vector<std::size_t> outOffsets, targets, weights;
+	std::vector<std::size_t> liveOut(numVertices, 0), liveIn(numVertices, 0), inSum(numVertices, 0);
+	std::vector<std::size_t> startingPoints;
+
+	// in an acyclic graph every vertex is its own strong component, and components are numbered
+	// in reverse topological order, so the vertices in topological order are the vertices sorted
+	// by decreasing component.
+	order.resize(numVertices);
+	for (std::size_t i = 0; i < numVertices; i++) {
+		order[numVertices - 1 - components->component(i)] = i;
+	}
+	for (std::size_t i = 0; i < numVertices; i++) {
+		position[order[i]] = i;
+	}
 
-double
-ProportionalPathBuilder::sumIncomingEdges(SkinnyGraph::Vertex v) {
-	double sum = 0;
+	// copy the edges (in the same order that they're stored in the graph) and their weights
+	// into flat arrays, along with the number and total weight of the live edges at each vertex.
+	BOOST_FOREACH (std::size_t i, order) {
+		outOffsets.push_back(targets.size());
+		BOOST_FOREACH (SkinnyGraph::Edge e, boost::out_edges(components->vertex(i), *g)) {
+			std::size_t target = position[components->vertexIndex(boost::target(e, *g))];
+			std::size_t weight = this->graph->edge(e)->getWeight();
+			targets.push_back(target);
+			weights.push_back(weight);
+			if (weight > 0) {
+				liveOut[position[i]]++;
+				liveIn[target]++;
+				inSum[target] += weight;
+			}
+		}
+	}
+	outOffsets.push_back(targets.size());
 
-	BOOST_FOREACH (SkinnyGraph::Edge e, getIncomingEdges(v)) {
-		sum += this->graph->edge(e)->getWeight();
+	BOOST_FOREACH (SkinnyGraph::Vertex v, getStartingPoints()) {
+		startingPoints.push_back(position[components->vertexIndex(v)]);
 	}
 
-	return sum;
-}
+	// this is the same walk as buildCyclicPaths, but a path can never revisit a vertex.
+	std::vector<std::size_t> followed, verticesFollowed;
+	std::size_t startingPoint = 0;
+	while (startingPoint < startingPoints.size() && withinBudget(paths.size())) {
+		double p = -1.;
+		std::size_t v = startingPoints[startingPoint];
+		std::size_t lastEdge = 0;
+		std::size_t smallestEdge = (std::size_t) -1;
 
-double
-ProportionalPathBuilder::sumOutgoingEdges(SkinnyGraph::Vertex v) {
-	double sum = 0;
+		followed.clear();
+		verticesFollowed.clear();
+		verticesFollowed.push_back(v);
 
-	BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
-		sum += this->graph->edge(e)->getWeight();
-	}
+		while (liveOut[v] > 0) {
+			// define a proportion from the edge we took to get here if more than one edge arrives here.
+			if (liveIn[v] > 1 && p < 0) {
+				p = weights[lastEdge] / (double) inSum[v];
+				TRACE(logger, "Selected proportion: [" << p << "].");
+			}
 
-	return sum;
-}
+			std::size_t maxEdge = 0, maxWeight = 0, sum = 0, only = 0;
+			for (std::size_t e = outOffsets[v]; e < outOffsets[v + 1]; e++) {
+				if (weights[e] > 0) {
+					sum += weights[e];
+					only = e;
+					if (weights[e] > maxWeight) {
+						maxWeight = weights[e];
+						maxEdge = e;
+					}
+				}
+			}
+
+			if (liveOut[v] == 1) {
+				lastEdge = only;
+			} else if (p < 0) {
+				// pick the edge with the largest weight and use it to define the proportion.
+				p = maxWeight / (double) sum;
+				lastEdge = maxEdge;
+			} else {
+				// look for an edge with a similar proportion, falling back to the largest edge.
+				bool found = false;
+				for (std::size_t e = outOffsets[v]; e < outOffsets[v + 1] && !found; e++) {
+					double edgeP = weights[e] / (double) sum;
+					if (weights[e] > 0 && edgeP > p - this->epsilon && edgeP < p + this->epsilon) {
+						lastEdge = e;
+						found = true;
+					}
+				}
+
+				if (!found) {
+					double maxEdgeP = maxWeight / (double) sum;
+					lastEdge = maxEdge;
+					if (maxEdgeP < p) {
+						p = maxEdgeP;
+					}
+				}
+			}
+
+			v = targets[lastEdge];
+			followed.push_back(lastEdge);
+			if (weights[lastEdge] > 1 && weights[lastEdge] < smallestEdge) {
+				smallestEdge = weights[lastEdge];
+			}
+			verticesFollowed.push_back(v);
+		}
 
-boost::tuple<SkinnyGraph::Edge, double>
-ProportionalPathBuilder::findMaxEdge(SkinnyGraph::Vertex v) {
-	SkinnyGraph::Edge maxEdge;
-	double maxWeight = 0;
+		// consume the edges that were followed, keeping the live counts and sums up to date.
+		BOOST_FOREACH (std::size_t e, followed) {
+			std::size_t amount = std::min(smallestEdge, weights[e]);
+			weights[e] -= amount;
+			inSum[targets[e]] -= amount;
+			if (weights[e] == 0) {
+				std::size_t source = std::upper_bound(outOffsets.begin(), outOffsets.end(), e) - outOffsets.begin() - 1;
+				liveOut[source]--;
+				liveIn[targets[e]]--;
+			}
+		}
 
-	BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
-		double weight = this->graph->edge(e)->getWeight();
-		if (weight > maxWeight) {
-			maxWeight = weight;
-			maxEdge = e;
+		std::vector<SkinnyGraph::Vertex> vertices;
+		vertices.reserve(verticesFollowed.size());
+		BOOST_FOREACH (std::size_t i, verticesFollowed) {
+			vertices.push_back(components->vertex(order[i]));
+		}
+		paths.insert(verticesToSequenceNodes(vertices));
+
+		if (p < 0) {
+			// no decisions were made on this path, so the starting point is exhausted.
+			startingPoint++;
 		}
 	}
+	TRACE(logger, "Built [" << paths.size() << "] paths through acyclic graph [" << this->graph->getId() << "].");
 
-	return boost::make_tuple(maxEdge, maxWeight);
+	return paths;
 }
 
-boost::tuple<SkinnyGraph::Edge, bool>
-ProportionalPathBuilder::findClosestEdge(SkinnyGraph::Vertex v, double p) {
-	SkinnyGraph::Edge closest;
-	bool found = false;
+double
+ProportionalPathBuilder::getEpsilon() {
+	return this->epsilon;
+}
 
-	double outgoingSum = sumOutgoingEdges(v);
+void
+ProportionalPathBuilder::setEpsilon(double epsilon) {
+	this->epsilon = epsilon;
+}
 
-	BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
-		boost::shared_ptr<WeightedEdge> edge = this->graph->edge(e);
-		double edgeP = edge->getWeight() / outgoingSum;
+double
+ProportionalPathBuilder::sumIncomingEdges(SkinnyGraph::Vertex v) {
+	double sum = 0;
 
-		if (edgeP > p - this->epsilon && edgeP < p + this->epsilon) {
-			closest = e;
-			found = true;
-			break;
-		}
+	BOOST_FOREACH (SkinnyGraph::Edge e, getIncomingEdges(v)) {
+		sum += this->graph->edge(e)->getWeight();
 	}
 
-	return boost::make_tuple(closest, found);
+	return sum;
 }
 
 #endif // PROPORTIONAL_PATH_BUILDER_CC
@@ -39,35 +39,28 @@ public:
 private:
 	/** epsilon used to construct paths */
 	double epsilon;
-	
-	/**
-	 * Sum the weights of the edges incoming to a certain vertex
-	 * @param v the vertex in question
-	 */
-	double sumIncomingEdges(SkinnyGraph::Vertex v);
 
 	/**
-	 * Sum the weights of the edges leaving a certain vertex
-	 * @param v the vertex in question
+	 * Construct paths through a graph that may contain cycles, stopping a path when it
+	 * arrives at a vertex it has already visited.
+	 * @return a set of proportional paths from the graph.
 	 */
-	double sumOutgoingEdges(SkinnyGraph::Vertex v);
+	boost::unordered_set<PathBuilder::Path> buildCyclicPaths();
 
 	/**
-	 * Find the edge with the largest weight exiting a node
-	 * @param v the vertex in question
-	 * @return a tuple in which first is the edge descriptor and second is its weight
+	 * Construct paths through a graph with no cycles. The edges are copied into flat arrays
+	 * in topological order along with running totals of the live edge weights at each vertex,
+	 * so each step only looks at the edges leaving the current vertex. Produces the same paths
+	 * as buildCyclicPaths.
+	 * @return a set of proportional paths from the graph.
 	 */
-	boost::tuple<SkinnyGraph::Edge, double> findMaxEdge(SkinnyGraph::Vertex v);
-
+	boost::unordered_set<PathBuilder::Path> buildAcyclicPaths();
+	
 	/**
-	 * Find the edge exiting a ndoe that has a proportion closest to that specified
+	 * Sum the weights of the edges incoming to a certain vertex
 	 * @param v the vertex in question
-	 * @param p the proportion to look for
-	 * @return a tuple in which first is an edge descriptor and second is a boolean
-	 * 	   indicating that (true) an edge with a proportion within epsilon WAS
-	 * 	   found, or (false) no such edge was found.
 	 */
-	boost::tuple<SkinnyGraph::Edge, bool> findClosestEdge(SkinnyGraph::Vertex v, double p);
+	double sumIncomingEdges(SkinnyGraph::Vertex v);
 };
 
 #endif // PROPORTIONAL_PATH_BUILDER_HH
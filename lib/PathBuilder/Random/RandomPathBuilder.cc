@@ -0,0 +1,215 @@
+/*
+ * File:   RandomPathBuilder.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef RANDOM_PATH_BUILDER_CC
+#define RANDOM_PATH_BUILDER_CC
+
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "PathBuilder/Random/RandomPathBuilder.hh"
+#include "Util/Util.hh"
+
+DECLARE_LOG(logger, "qassembler.RandomPathBuilder");
+
+/** the number of times each path was walked */
+typedef boost::unordered_map<PathBuilder::Path, std::size_t> PathFrequencies;
+
+/**
+ * A distinct path, with what it takes to rank it.
+ */
+struct RankedPath {
+	/** the number of walks that followed the path */
+	std::size_t frequency;
+	/** the path */
+	PathBuilder::Path path;
+};
+
+/**
+ * Order sequence nodes by their identifiers.
+ */
+static bool lowerId(const boost::shared_ptr<SequenceNode> &a, const boost::shared_ptr<SequenceNode> &b) {
+	return a->getId() < b->getId();
+}
+
+/**
+ * Order paths by how often they were walked (most often first), then by the identifiers of
+ * the vertices that they visit.
+ */
+static bool moreFrequent(const RankedPath &a, const RankedPath &b) {
+	if (a.frequency != b.frequency) {
+		return a.frequency > b.frequency;
+	}
+	return std::lexicographical_compare(a.path.begin(), a.path.end(), b.path.begin(), b.path.end(), lowerId);
+}
+
+RandomPathBuilder::RandomPathBuilder(boost::shared_ptr<SkinnyGraph> graph, std::size_t walks, std::size_t threads, uint64_t seed) :
+		PathBuilder(graph), walks(walks), threads(std::max<std::size_t>(threads, 1)), seed(seed) {}
+
+boost::unordered_set<PathBuilder::Path>
+RandomPathBuilder::buildPaths() {
+	boost::unordered_set<PathBuilder::Path> paths;
+	std::vector<WalkCounts> counts(this->threads);
+	boost::thread_group group;
+	std::size_t taken = 0;
+
+	snapshot();
+	this->frequencies.clear();
+
+	if (this->startingPoints.empty()) {
+		return paths;
+	}
+
+	// each thread takes a contiguous range of walks. the random numbers for a walk only depend
+	// on the index of the walk, so the split doesn't change which paths are found.
+	DEBUG(logger, "Taking [" << this->walks << "] walks on [" << this->threads << "] threads through graph [" << this->graph->getId() << "].");
+	for (std::size_t t = 1; t < this->threads; t++) {
+		std::size_t first = this->walks * t / this->threads;
+		std::size_t last = this->walks * (t + 1) / this->threads;
+		group.create_thread(boost::bind(&RandomPathBuilder::walk, this, first, last, boost::ref(counts[t])));
+	}
+	walk(0, this->walks / this->threads, counts[0]);
+	group.join_all();
+
+	// merge the walks from every thread before choosing which paths to keep, so that the paths
+	// that are kept don't depend on how the walks were split between threads.
+	PathFrequencies walked;
+	BOOST_FOREACH (const WalkCounts &threadCounts, counts) {
+		BOOST_FOREACH (const WalkCounts::value_type &wc, threadCounts) {
+			std::vector<SkinnyGraph::Vertex> walkedVertices;
+			walkedVertices.reserve(wc.first.size());
+			BOOST_FOREACH (std::size_t v, wc.first) {
+				walkedVertices.push_back(this->vertices[v]);
+			}
+
+			walked[verticesToSequenceNodes(walkedVertices)] += wc.second;
+			taken += wc.second;
+		}
+	}
+
+	// when the number of paths is limited, the most frequently walked paths are kept (ties are
+	// broken by the vertices that the paths visit).
+	std::vector<RankedPath> ranked;
+	ranked.reserve(walked.size());
+	BOOST_FOREACH (const PathFrequencies::value_type &pf, walked) {
+		RankedPath r = { pf.second, pf.first };
+		ranked.push_back(r);
+	}
+	std::sort(ranked.begin(), ranked.end(), moreFrequent);
+
+	BOOST_FOREACH (const RankedPath &r, ranked) {
+		if (this->budget && this->budget->full(paths.size())) {
+			withinBudget(paths.size());
+			break;
+		}
+		this->frequencies[r.path] = r.frequency;
+		paths.insert(r.path);
+	}
+	// walks stop early when the time runs out, but the walks that were taken are still reported.
+	if (taken < this->walks) {
+		withinBudget(paths.size());
+	}
+	DEBUG(logger, "Found [" << paths.size() << "] distinct paths in graph [" << this->graph->getId() << "].");
+
+	return paths;
+}
+
+boost::unordered_map<PathBuilder::Path, std::size_t>
+RandomPathBuilder::getPathFrequencies() {
+	return this->frequencies;
+}
+
+void
+RandomPathBuilder::snapshot() {
+	boost::unordered_map<SkinnyGraph::Vertex, std::size_t> index;
+	boost::shared_ptr<SkinnyGraph::Graph> g = this->graph->graph();
+
+	this->vertices.clear();
+	this->startingPoints.clear();
+	this->edgeOffsets.clear();
+	this->edgeTargets.clear();
+	this->cumulativeWeights.clear();
+
+	BOOST_FOREACH (SkinnyGraph::Vertex v, getStartingPoints()) {
+		index[v] = this->vertices.size();
+		this->startingPoints.push_back(this->vertices.size());
+		this->vertices.push_back(v);
+	}
+	BOOST_FOREACH (SkinnyGraph::Vertex v, this->graph->getVertexIterators()) {
+		if (index.find(v) == index.end()) {
+			index[v] = this->vertices.size();
+			this->vertices.push_back(v);
+		}
+	}
+
+	BOOST_FOREACH (SkinnyGraph::Vertex v, this->vertices) {
+		double total = 0.;
+		this->edgeOffsets.push_back(this->edgeTargets.size());
+		BOOST_FOREACH (SkinnyGraph::Edge e, getOutgoingEdges(v)) {
+			total += this->graph->edge(e)->getWeight();
+			this->edgeTargets.push_back(index[boost::target(e, *g)]);
+			this->cumulativeWeights.push_back(total);
+		}
+	}
+	this->edgeOffsets.push_back(this->edgeTargets.size());
+}
+
+void
+RandomPathBuilder::walk(std::size_t first, std::size_t last, WalkCounts &counts) const {
+	std::vector<bool> visited(this->vertices.size(), false);
+	Walk current;
+
+	for (std::size_t w = first; w < last; w++) {
+		// the budget can be checked from any thread, but only buildPaths records that it ran out.
+		if (this->budget && this->budget->expired()) {
+			break;
+		}
+		std::size_t v = this->startingPoints[w % this->startingPoints.size()];
+		uint64_t step = 0;
+
+		current.clear();
+		current.push_back(v);
+		visited[v] = true;
+
+		// follow weighted edges until we reach a vertex with no outgoing edges, or a vertex that
+		// this walk has already visited (a cycle).
+		while (this->edgeOffsets[v] < this->edgeOffsets[v + 1]) {
+			std::vector<double>::const_iterator begin = this->cumulativeWeights.begin() + this->edgeOffsets[v];
+			std::vector<double>::const_iterator end = this->cumulativeWeights.begin() + this->edgeOffsets[v + 1];
+			double u = uniform(w, step++) * *(end - 1);
+			std::size_t selected = std::upper_bound(begin, end, u) - begin;
+			if (selected == (std::size_t) (end - begin)) {
+				selected--;
+			}
+
+			v = this->edgeTargets[this->edgeOffsets[v] + selected];
+			if (visited[v]) {
+				break;
+			}
+			current.push_back(v);
+			visited[v] = true;
+		}
+
+		BOOST_FOREACH (std::size_t visitedVertex, current) {
+			visited[visitedVertex] = false;
+		}
+		counts[current]++;
+	}
+}
+
+double
+RandomPathBuilder::uniform(uint64_t walk, uint64_t step) const {
+	// mix a counter derived from the seed, walk and step.
+	uint64_t z = qassembler::mix(this->seed + walk * 0x9E3779B97F4A7C15ULL + (step + 1) * 0xD1B54A32D192ED03ULL);
+
+	// use the top 53 bits as the mantissa of a double in [0, 1).
+	return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif // RANDOM_PATH_BUILDER_CC
@@ -0,0 +1,92 @@
+/*
+ * File:   RandomPathBuilder.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef RANDOM_PATH_BUILDER_HH
+#define RANDOM_PATH_BUILDER_HH
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "PathBuilder/PathBuilder.hh"
+#include "Logging/Logging.hh"
+
+class RandomPathBuilder: public PathBuilder {
+public:
+	/**
+	 * Constructor.
+	 * @param graph the graph to use to construct paths
+	 * @param walks the number of random walks to take through the graph
+	 * @param threads the number of threads to take walks on
+	 * @param seed the seed for the random number streams
+	 */
+	RandomPathBuilder(boost::shared_ptr<SkinnyGraph> graph, std::size_t walks, std::size_t threads, uint64_t seed);
+
+	/**
+	 * Construct paths from the supplied graph by taking independent weighted random walks
+	 * from each of the starting points. Edge weights are never modified, so walks can be
+	 * taken in parallel. Each walk draws random numbers from its own stream, so the paths
+	 * are the same for a given seed regardless of the number of threads. If the number of
+	 * paths is limited, the most frequently walked paths are kept.
+	 * @return the distinct paths that were walked.
+	 */
+	boost::unordered_set<PathBuilder::Path> buildPaths();
+
+	/**
+	 * Get the number of walks that followed each path in the most recent call to buildPaths.
+	 * @return the number of times each distinct path was walked.
+	 */
+	boost::unordered_map<PathBuilder::Path, std::size_t> getPathFrequencies();
+private:
+	/** a walk through the graph, using dense vertex identifiers */
+	typedef std::vector<std::size_t> Walk;
+	/** the number of times each walk was taken */
+	typedef boost::unordered_map<Walk, std::size_t> WalkCounts;
+
+	/** the number of walks to take */
+	std::size_t walks;
+	/** the number of threads to take walks on */
+	std::size_t threads;
+	/** the seed for the random number streams */
+	uint64_t seed;
+
+	/** the vertices of the graph, by dense identifier */
+	std::vector<SkinnyGraph::Vertex> vertices;
+	/** the dense identifiers of the vertices with no incoming edges */
+	std::vector<std::size_t> startingPoints;
+	/** the position in edgeTargets of the first edge leaving each vertex (one extra entry marks the end) */
+	std::vector<std::size_t> edgeOffsets;
+	/** the dense identifier of the target of each live edge */
+	std::vector<std::size_t> edgeTargets;
+	/** the running total of the weights of the edges leaving each vertex */
+	std::vector<double> cumulativeWeights;
+	/** the number of times each path was walked */
+	boost::unordered_map<PathBuilder::Path, std::size_t> frequencies;
+
+	/**
+	 * Copy the live edges and their weights into flat arrays that can be shared by all threads.
+	 */
+	void snapshot();
+
+	/**
+	 * Take a range of walks through the snapshot.
+	 * @param first the index of the first walk to take
+	 * @param last one past the index of the last walk to take
+	 * @param counts where to count the walks that were taken
+	 */
+	void walk(std::size_t first, std::size_t last, WalkCounts &counts) const;
+
+	/**
+	 * Generate a uniform random number for a step of a walk. The number only depends on
+	 * its arguments, so every walk has an independent stream.
+	 * @param walk the index of the walk
+	 * @param step the index of the step within the walk
+	 * @return a uniform random number in [0, 1)
+	 */
+	double uniform(uint64_t walk, uint64_t step) const;
+};
+
+#endif // RANDOM_PATH_BUILDER_HH
@@ -10,7 +10,7 @@
 #include "PreHash.hh"
 
 #include <boost/foreach.hpp>
-#include <boost/algorithm/string.hpp>
+#include <algorithm>
 
 DECLARE_LOG(logger, "qassembler.PreHash");
 
@@ -36,16 +36,24 @@ PreHash::addRead(boost::shared_ptr<Sequence> read) {
 }
 
 void
-PreHash::addRead(std::string sequence, std::size_t readId, Kmer::Strand direction) {
-	std::string upperSequence = boost::to_upper_copy(sequence);
-	std::string subseq = upperSequence.substr(0, kmerLength);
-	std::size_t hash = qassembler::hash(subseq);
+PreHash::addReads(const ReadBatch &batch) {
+	for (std::size_t i = 0; i < batch.size(); i++) {
+		for (std::size_t s = 0; s < batch.segments(i); s++) {
+			addRead(batch.segment(i, s), batch.id(i), Kmer::FORWARD);
+			addRead(batch.segmentReverseComplement(i, s), batch.id(i), Kmer::REVERSE);
+		}
+	}
+}
+
+void
+PreHash::addRead(boost::string_ref sequence, std::size_t readId, Kmer::Strand direction) {
+	// a read shorter than k contributes a single (short) k-mer.
+	std::size_t first = std::min(kmerLength, sequence.size());
+	std::size_t hash = qassembler::hash(sequence.data(), sequence.data() + first);
 	addKmer(hash, readId, direction, kmerLength - 1);
 
-	for (std::size_t i = kmerLength; i < upperSequence.length(); i++) {
-		subseq.erase(0, 1);
-		subseq.push_back(upperSequence[i]);
-		hash = qassembler::hash(subseq);
+	for (std::size_t i = kmerLength; i < sequence.size(); i++) {
+		hash = qassembler::hash(sequence.data() + i + 1 - kmerLength, sequence.data() + i + 1);
 		addKmer(hash, readId, direction, i);
 	}
 }
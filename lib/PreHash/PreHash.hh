@@ -17,6 +17,7 @@
 #include "Util/Util.hh"
 #include "Kmer/Kmer.hh"
 #include "Sequence/Sequence.hh"
+#include "Sequence/ReadBatch.hh"
 
 #include "Logging/Logging.hh"
 
@@ -39,6 +40,13 @@ public:
 	 */
 	void addRead(boost::shared_ptr<Sequence> read);
 
+	/**
+	 * add the segments of every read in a (normalised) batch to this pre-hash. k-mers are
+	 * hashed where they are in the batch, without being copied.
+	 * @param batch the reads to use when generating k-mers
+	 */
+	void addReads(const ReadBatch &batch);
+
 	/**
 	 * get the hashes that belong to a specific read in a specific orientation
 	 * @param readId the read to get hashes for
@@ -75,12 +83,12 @@ public:
 	boost::unordered_set<std::size_t> getAllHashes();
 private:
 	/**
-	 * Add a read from a string.
-	 * @param sequence the sequence to add.
+	 * Add one strand of a read.
+	 * @param sequence the (upper-case) sequence to add.
 	 * @param readId the read identifier.
 	 * @param strand the strand used when the read is being added.
 	 */
-	void addRead(std::string sequence, std::size_t readId, Kmer::Strand strand);
+	void addRead(boost::string_ref sequence, std::size_t readId, Kmer::Strand strand);
 	/**
 	 * Add a kmer to this pre-hash.
 	 * @param hash the hash to add for the kmer.
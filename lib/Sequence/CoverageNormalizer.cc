@@ -0,0 +1,136 @@
+/*
+ * File:   CoverageNormalizer.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef COVERAGE_NORMALIZER_CC
+#define COVERAGE_NORMALIZER_CC
+
+#include <algorithm>
+#include <limits>
+
+#include "Sequence/CoverageNormalizer.hh"
+#include "Util/Util.hh"
+
+/** the number of rows in each sketch */
+#define SKETCH_DEPTH 4
+/** spreads the rows of a sketch apart */
+#define ROW_SEED 0x9E3779B97F4A7C15ULL
+
+CoverageNormalizer::CoverageNormalizer(std::size_t kmerLength, std::size_t coverage, std::size_t width) :
+		kmerLength(kmerLength), coverage(coverage), mask(1), readCount(0), keptCount(0) {
+	while (this->mask < width) {
+		this->mask <<= 1;
+	}
+	this->all.assign(SKETCH_DEPTH * this->mask, 0);
+	this->normalized.assign(SKETCH_DEPTH * this->mask, 0);
+	this->mask--;
+}
+
+void
+CoverageNormalizer::normalize(ReadBatch &batch) {
+	for (std::size_t i = 0; i < batch.size(); i++) {
+		std::size_t copies = batch.copies(i);
+		if (copies == 0) {
+			continue;
+		}
+
+		this->hashes.clear();
+		for (std::size_t s = 0; s < batch.segments(i); s++) {
+			boost::string_ref forward = batch.segment(i, s);
+			boost::string_ref reverse = batch.segmentReverseComplement(i, s);
+
+			for (std::size_t j = 0; j + kmerLength <= forward.size(); j++) {
+				this->hashes.push_back(qassembler::hash(forward.data() + j, forward.data() + j + kmerLength));
+				this->hashes.push_back(qassembler::hash(reverse.data() + j, reverse.data() + j + kmerLength));
+			}
+		}
+
+		this->readCount += copies;
+
+		// reads without any k-mers don't add anything to the graph either way.
+		if (this->hashes.empty()) {
+			this->keptCount += copies;
+			continue;
+		}
+
+		this->abundances.clear();
+		for (std::vector<std::size_t>::const_iterator h = this->hashes.begin(); h != this->hashes.end(); ++h) {
+			this->abundances.push_back(estimate(this->normalized, *h));
+		}
+		std::vector<std::size_t>::iterator median = this->abundances.begin() + this->abundances.size() / 2;
+		std::nth_element(this->abundances.begin(), median, this->abundances.end());
+
+		// keep as many copies of the read as it takes to reach the target coverage.
+		std::size_t keep = *median < this->coverage ? std::min(copies, this->coverage - *median) : 0;
+
+		for (std::vector<std::size_t>::const_iterator h = this->hashes.begin(); h != this->hashes.end(); ++h) {
+			add(this->all, *h, copies);
+			if (keep > 0) {
+				add(this->normalized, *h, keep);
+			}
+		}
+
+		this->keptCount += keep;
+		batch.setCopies(i, keep);
+	}
+}
+
+std::size_t
+CoverageNormalizer::observed(std::size_t hash) const {
+	return estimate(this->all, hash);
+}
+
+std::size_t
+CoverageNormalizer::kept(std::size_t hash) const {
+	return estimate(this->normalized, hash);
+}
+
+double
+CoverageNormalizer::scale(std::size_t hash) const {
+	std::size_t keptAbundance = kept(hash);
+	std::size_t observedAbundance = observed(hash);
+
+	if (keptAbundance == 0 || observedAbundance <= keptAbundance) {
+		return 1.0;
+	}
+	return static_cast<double>(observedAbundance) / keptAbundance;
+}
+
+std::size_t
+CoverageNormalizer::reads() const {
+	return this->readCount;
+}
+
+std::size_t
+CoverageNormalizer::keptReads() const {
+	return this->keptCount;
+}
+
+std::size_t
+CoverageNormalizer::estimate(const Sketch &sketch, std::size_t hash) const {
+	std::size_t count = std::numeric_limits<std::size_t>::max();
+
+	for (std::size_t row = 0; row < SKETCH_DEPTH; row++) {
+		count = std::min(count, static_cast<std::size_t>(sketch[slot(row, hash)]));
+	}
+	return count;
+}
+
+void
+CoverageNormalizer::add(Sketch &sketch, std::size_t hash, std::size_t count) {
+	for (std::size_t row = 0; row < SKETCH_DEPTH; row++) {
+		uint32_t &counter = sketch[slot(row, hash)];
+		// counters saturate instead of wrapping.
+		counter = static_cast<uint32_t>(std::min<uint64_t>(static_cast<uint64_t>(counter) + count,
+			std::numeric_limits<uint32_t>::max()));
+	}
+}
+
+std::size_t
+CoverageNormalizer::slot(std::size_t row, std::size_t hash) const {
+	return row * (this->mask + 1) + (qassembler::mix(hash + row * ROW_SEED) & this->mask);
+}
+
+#endif // COVERAGE_NORMALIZER_CC
@@ -0,0 +1,108 @@
+/*
+ * File:   CoverageNormalizer.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef COVERAGE_NORMALIZER_HH
+#define COVERAGE_NORMALIZER_HH
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "Sequence/ReadBatch.hh"
+
+/**
+ * Digital normalisation: drop reads from regions that are already covered deeply enough. The
+ * abundance of each k-mer in the reads that have been kept is estimated with a count-min
+ * sketch; a read whose median k-mer abundance has reached the target coverage adds nothing new
+ * to the structure of the graph, so it's dropped. A second sketch counts the k-mers of every
+ * read, so that the weights of a graph built from the kept reads can be scaled back up to the
+ * coverage of all of the reads.
+ *
+ * Both strands of every k-mer are counted, so k-mers can be looked up by the hash of either
+ * strand.
+ */
+class CoverageNormalizer {
+public:
+	/**
+	 * Constructor.
+	 * @param kmerLength the length of the k-mers that are taken from the reads
+	 * @param coverage the median k-mer abundance at which reads are dropped
+	 * @param width the number of counters in each row of the sketches (rounded up to a power of two)
+	 */
+	CoverageNormalizer(std::size_t kmerLength, std::size_t coverage, std::size_t width = 1 << 20);
+
+	/**
+	 * Drop the reads in a (normalised and filtered) batch whose median k-mer abundance has
+	 * reached the target coverage. Dropped reads stand for no copies afterwards. If the batch
+	 * was collapsed, each record is counted as many times as the copies it stands for.
+	 * @param batch the batch to normalise.
+	 */
+	void normalize(ReadBatch &batch);
+
+	/**
+	 * Estimate how many times a k-mer was seen in all of the reads.
+	 * @param hash the hash of (either strand of) the k-mer
+	 * @return the estimated abundance.
+	 */
+	std::size_t observed(std::size_t hash) const;
+
+	/**
+	 * Estimate how many times a k-mer was seen in the reads that were kept.
+	 * @param hash the hash of (either strand of) the k-mer
+	 * @return the estimated abundance.
+	 */
+	std::size_t kept(std::size_t hash) const;
+
+	/**
+	 * How much should the weight of a k-mer in a graph built from the kept reads be scaled
+	 * by to match the coverage of all of the reads?
+	 * @param hash the hash of (either strand of) the k-mer
+	 * @return the ratio of the observed to the kept abundance of the k-mer (at least 1).
+	 */
+	double scale(std::size_t hash) const;
+
+	/** how many reads have been seen? */
+	std::size_t reads() const;
+	/** how many of the reads were kept? */
+	std::size_t keptReads() const;
+private:
+	/** a count-min sketch */
+	typedef std::vector<uint32_t> Sketch;
+
+	/** the length of the k-mers taken from the reads */
+	std::size_t kmerLength;
+	/** the median k-mer abundance at which reads are dropped */
+	std::size_t coverage;
+	/** the number of counters in each row of a sketch, minus one */
+	std::size_t mask;
+	/** the k-mers of every read */
+	Sketch all;
+	/** the k-mers of the kept reads */
+	Sketch normalized;
+	/** the number of reads seen */
+	std::size_t readCount;
+	/** the number of reads kept */
+	std::size_t keptCount;
+
+	/** the hashes of both strands of the k-mers of a read */
+	std::vector<std::size_t> hashes;
+	/** the abundances of the k-mers of a read */
+	std::vector<std::size_t> abundances;
+
+	/**
+	 * Estimate the count of a hash in a sketch.
+	 */
+	std::size_t estimate(const Sketch &sketch, std::size_t hash) const;
+	/**
+	 * Count a hash in a sketch.
+	 */
+	void add(Sketch &sketch, std::size_t hash, std::size_t count);
+	/**
+	 * Find the counter for a hash in a row of a sketch.
+	 */
+	std::size_t slot(std::size_t row, std::size_t hash) const;
+};
+
+#endif // COVERAGE_NORMALIZER_HH
@@ -0,0 +1,229 @@
+/*
+ * File:   ReadBatch.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_BATCH_CC
+#define READ_BATCH_CC
+
+#include <cctype>
+#include <boost/functional/hash.hpp>
+
+#include "Sequence/ReadBatch.hh"
+#include "Sequence/Sequence.hh"
+#include "Exception/InvalidInputException.hh"
+
+ReadBatch::ReadBatch(std::size_t capacity) : normalised(false), source(0) {
+	this->records.reserve(capacity);
+}
+
+void
+ReadBatch::add(boost::string_ref sequence, boost::string_ref name, boost::string_ref comment, boost::string_ref qual) {
+	Record r;
+
+	if (this->normalised) {
+		throw InvalidInputException("Records can't be added to a normalised batch.");
+	}
+
+	r.sequence = append(sequence);
+	r.sequenceLength = sequence.size();
+	r.name = append(name);
+	r.nameLength = name.size();
+	r.comment = append(comment);
+	r.commentLength = comment.size();
+	r.qual = append(qual);
+	r.qualLength = qual.size();
+	r.reverse = 0;
+	r.id = 0;
+	r.firstSegment = 0;
+	r.segmentCount = 0;
+	r.copies = 1;
+	r.repeated = false;
+
+	this->records.push_back(r);
+}
+
+void
+ReadBatch::setSource(std::size_t source) {
+	if (this->normalised) {
+		throw InvalidInputException("The source of a normalised batch can't be changed.");
+	}
+
+	this->source = source;
+}
+
+void
+ReadBatch::normalise() {
+	std::size_t bases = 0;
+
+	if (this->normalised) {
+		return;
+	}
+
+	// make room for all of the reverse complements at once.
+	for (std::size_t i = 0; i < this->records.size(); i++) {
+		bases += this->records[i].sequenceLength;
+	}
+	this->arena.reserve(this->arena.size() + bases);
+	this->segmentRanges.reserve(this->records.size());
+
+	for (std::size_t i = 0; i < this->records.size(); i++) {
+		Record &r = this->records[i];
+
+		for (std::size_t b = r.sequence; b < r.sequence + r.sequenceLength; b++) {
+			this->arena[b] = toupper(this->arena[b]);
+		}
+
+		// there's already room for the reverse complement, so arena never moves here.
+		r.reverse = this->arena.size();
+		for (std::size_t b = r.sequenceLength; b > 0; b--) {
+			this->arena.push_back(Sequence::complement(this->arena[r.sequence + b - 1]));
+		}
+
+		// the same as hashing the name as a std::string.
+		r.id = boost::hash_range(this->arena.begin() + r.name, this->arena.begin() + r.name + r.nameLength);
+		if (this->source > 0) {
+			boost::hash_combine(r.id, this->source);
+		}
+
+		r.firstSegment = this->segmentRanges.size();
+		r.segmentCount = 1;
+		this->segmentRanges.push_back(ReadSegment(0, r.sequenceLength));
+	}
+
+	this->normalised = true;
+}
+
+void
+ReadBatch::filter(const ReadFilter &filter) {
+	std::vector<ReadSegment> segments;
+
+	if (!this->normalised) {
+		throw InvalidInputException("Only a normalised batch can be filtered.");
+	}
+
+	segments.reserve(this->records.size());
+	for (std::size_t i = 0; i < this->records.size(); i++) {
+		Record &r = this->records[i];
+		if (filter.resolvesAmbiguity()) {
+			// change both strands, so that they're still each other's reverse complement.
+			for (std::size_t b = 0; b < r.sequenceLength; b++) {
+				char resolved = ReadFilter::resolve(this->arena[r.sequence + b]);
+				if (resolved != this->arena[r.sequence + b]) {
+					this->arena[r.sequence + b] = resolved;
+					this->arena[r.reverse + r.sequenceLength - b - 1] = Sequence::complement(resolved);
+				}
+			}
+		}
+
+		r.firstSegment = segments.size();
+		filter.split(sequence(i), qual(i), segments);
+		r.segmentCount = segments.size() - r.firstSegment;
+	}
+
+	this->segmentRanges.swap(segments);
+}
+
+std::size_t
+ReadBatch::size() const {
+	return this->records.size();
+}
+
+bool
+ReadBatch::empty() const {
+	return this->records.empty();
+}
+
+std::size_t
+ReadBatch::bytes() const {
+	return this->arena.size();
+}
+
+boost::string_ref
+ReadBatch::sequence(std::size_t read) const {
+	return view(this->records[read].sequence, this->records[read].sequenceLength);
+}
+
+boost::string_ref
+ReadBatch::reverseComplement(std::size_t read) const {
+	return view(this->records[read].reverse, this->records[read].sequenceLength);
+}
+
+boost::string_ref
+ReadBatch::name(std::size_t read) const {
+	return view(this->records[read].name, this->records[read].nameLength);
+}
+
+boost::string_ref
+ReadBatch::comment(std::size_t read) const {
+	return view(this->records[read].comment, this->records[read].commentLength);
+}
+
+boost::string_ref
+ReadBatch::qual(std::size_t read) const {
+	return view(this->records[read].qual, this->records[read].qualLength);
+}
+
+std::size_t
+ReadBatch::id(std::size_t read) const {
+	return this->records[read].id;
+}
+
+std::size_t
+ReadBatch::segments(std::size_t read) const {
+	return this->records[read].segmentCount;
+}
+
+boost::string_ref
+ReadBatch::segment(std::size_t read, std::size_t s) const {
+	const ReadSegment &segment = this->segmentRanges[this->records[read].firstSegment + s];
+	return view(this->records[read].sequence + segment.start, segment.length);
+}
+
+boost::string_ref
+ReadBatch::segmentReverseComplement(std::size_t read, std::size_t s) const {
+	const Record &r = this->records[read];
+	const ReadSegment &segment = this->segmentRanges[r.firstSegment + s];
+	// the segment is at the other end of the reverse complement.
+	return view(r.reverse + r.sequenceLength - segment.start - segment.length, segment.length);
+}
+
+std::size_t
+ReadBatch::copies(std::size_t read) const {
+	return this->records[read].copies;
+}
+
+void
+ReadBatch::setCopies(std::size_t read, std::size_t copies) {
+	this->records[read].copies = copies;
+}
+
+bool
+ReadBatch::repeated(std::size_t read) const {
+	return this->records[read].repeated;
+}
+
+void
+ReadBatch::setRepeated(std::size_t read, bool repeated) {
+	this->records[read].repeated = repeated;
+}
+
+std::size_t
+ReadBatch::append(boost::string_ref s) {
+	std::size_t start = this->arena.size();
+
+	this->arena.insert(this->arena.end(), s.begin(), s.end());
+	return start;
+}
+
+boost::string_ref
+ReadBatch::view(std::size_t start, std::size_t length) const {
+	if (length == 0) {
+		return boost::string_ref();
+	}
+
+	return boost::string_ref(&this->arena[start], length);
+}
+
+#endif // READ_BATCH_CC
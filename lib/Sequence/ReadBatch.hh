@@ -0,0 +1,145 @@
+/*
+ * File:   ReadBatch.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_BATCH_HH
+#define READ_BATCH_HH
+
+#include <string>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+
+#include "Sequence/ReadFilter.hh"
+
+/**
+ * A batch of sequence records whose bases, reverse complements, names, comments and qualities
+ * all live in one contiguous buffer. Records are added as they are read, then the batch is
+ * normalised (upper-cased, named and reverse complemented) in one pass, after which the parts
+ * of each record can be looked at without copying them.
+ *
+ * k-mers are taken from the segments of each record. Until the batch is filtered, each record
+ * has one segment covering the whole record.
+ *
+ * Each record stands for one read until the batch is collapsed (see ReadCollapser), after which
+ * a record may stand for several identical reads, or none.
+ */
+class ReadBatch {
+public:
+	/**
+	 * Constructor.
+	 * @param capacity the number of records to make room for
+	 */
+	ReadBatch(std::size_t capacity = 0);
+
+	/**
+	 * Append a record to the batch. The parts of the record are copied into the batch.
+	 * @param sequence the bases of the record
+	 * @param name the name of the record
+	 * @param comment the comment of the record
+	 * @param qual the qualities of the record (empty for fasta records)
+	 */
+	void add(boost::string_ref sequence, boost::string_ref name, boost::string_ref comment, boost::string_ref qual);
+
+	/**
+	 * Say which input file the records came from. Records from different files get identifiers
+	 * in different namespaces, so that (for example) both mates of a pair can have the same
+	 * name. Records from file 0 get the same identifiers as Sequence gives them.
+	 * @param source the index of the file the records came from
+	 */
+	void setSource(std::size_t source);
+
+	/**
+	 * Upper-case the bases of every record, compute their identifiers and reverse complements.
+	 * Views of the records are only valid after the batch is normalised, and no more records
+	 * may be added afterwards.
+	 * @throws InvalidInputException if a record contains something other than bases.
+	 */
+	void normalise();
+
+	/**
+	 * Split every record in a (normalised) batch into the segments admitted by a filter. If
+	 * the filter resolves ambiguous bases, they're resolved (on both strands) first.
+	 * @param filter the filter that decides which segments are kept
+	 * @throws InvalidInputException if the batch isn't normalised yet.
+	 */
+	void filter(const ReadFilter &filter);
+
+	/** how many records are in the batch? */
+	std::size_t size() const;
+	/** is the batch empty? */
+	bool empty() const;
+	/** how many bytes are used by the records in the batch? */
+	std::size_t bytes() const;
+
+	/** the (upper-case) bases of a record */
+	boost::string_ref sequence(std::size_t read) const;
+	/** the reverse complement of the bases of a record */
+	boost::string_ref reverseComplement(std::size_t read) const;
+	/** the name of a record */
+	boost::string_ref name(std::size_t read) const;
+	/** the comment of a record */
+	boost::string_ref comment(std::size_t read) const;
+	/** the qualities of a record */
+	boost::string_ref qual(std::size_t read) const;
+	/** the identifier of a record (for file 0, the same identifier that Sequence computes) */
+	std::size_t id(std::size_t read) const;
+
+	/** how many segments does a record have? */
+	std::size_t segments(std::size_t read) const;
+	/** the bases of a segment of a record */
+	boost::string_ref segment(std::size_t read, std::size_t s) const;
+	/** the reverse complement of the bases of a segment of a record */
+	boost::string_ref segmentReverseComplement(std::size_t read, std::size_t s) const;
+
+	/** how many reads does a record stand for? (0 if it was collapsed into another record) */
+	std::size_t copies(std::size_t read) const;
+	/** set how many reads a record stands for */
+	void setCopies(std::size_t read, std::size_t copies);
+	/** was a read identical to this record already added to the graph from an earlier batch? */
+	bool repeated(std::size_t read) const;
+	/** set whether a read identical to this record was already added to the graph */
+	void setRepeated(std::size_t read, bool repeated);
+private:
+	/** where the parts of a record are in the buffer */
+	struct Record {
+		std::size_t sequence, reverse, name, comment, qual;
+		std::size_t sequenceLength, nameLength, commentLength, qualLength;
+		std::size_t id;
+		/** where the segments of the record are in segmentRanges */
+		std::size_t firstSegment, segmentCount;
+		/** the number of identical reads that the record stands for */
+		std::size_t copies;
+		/** was an identical read seen in an earlier batch? */
+		bool repeated;
+	};
+
+	/** the parts of all of the records */
+	std::vector<char> arena;
+	/** the records */
+	std::vector<Record> records;
+	/** the segments of all of the records */
+	std::vector<ReadSegment> segmentRanges;
+	/** has the batch been normalised? */
+	bool normalised;
+	/** the index of the file the records came from */
+	std::size_t source;
+
+	/**
+	 * Copy a string to the end of the buffer.
+	 * @param s the string to copy
+	 * @return the position of the copy in the buffer.
+	 */
+	std::size_t append(boost::string_ref s);
+
+	/**
+	 * Get a view of part of the buffer.
+	 * @param start the position of the first character
+	 * @param length the number of characters
+	 * @return the view.
+	 */
+	boost::string_ref view(std::size_t start, std::size_t length) const;
+};
+
+#endif // READ_BATCH_HH
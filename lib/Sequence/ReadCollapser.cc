@@ -0,0 +1,88 @@
+/*
+ * File:   ReadCollapser.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_COLLAPSER_CC
+#define READ_COLLAPSER_CC
+
+#include <boost/unordered_map.hpp>
+
+#include "Sequence/ReadCollapser.hh"
+#include "Util/Util.hh"
+
+/** FNV-1a parameters for the first half of the digest */
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+/** polynomial hash parameters for the second half of the digest */
+#define POLY_SEED 0x6A09E667F3BCC908ULL
+#define POLY_BASE 0x9E3779B97F4A7C15ULL
+/** marks the end of a segment, so that segments can't run into each other */
+#define SEGMENT_END '|'
+
+/**
+ * Extend both halves of a digest by a run of characters.
+ */
+static void extend(uint64_t &fnv, uint64_t &poly, boost::string_ref s) {
+	for (boost::string_ref::const_iterator c = s.begin(); c != s.end(); ++c) {
+		fnv = (fnv ^ static_cast<unsigned char>(*c)) * FNV_PRIME;
+		poly = poly * POLY_BASE + static_cast<unsigned char>(*c);
+	}
+	fnv = (fnv ^ SEGMENT_END) * FNV_PRIME;
+	poly = poly * POLY_BASE + SEGMENT_END;
+}
+
+ReadCollapser::ReadCollapser() : total(0) {}
+
+void
+ReadCollapser::collapse(ReadBatch &batch) {
+	// the first record for each read in this batch.
+	boost::unordered_map<Digest, std::size_t> first;
+
+	for (std::size_t i = 0; i < batch.size(); i++) {
+		Digest digest = canonical(batch, i);
+		boost::unordered_map<Digest, std::size_t>::iterator found = first.find(digest);
+
+		if (found != first.end()) {
+			batch.setCopies(found->second, batch.copies(found->second) + batch.copies(i));
+			batch.setCopies(i, 0);
+		} else {
+			first.insert(std::make_pair(digest, i));
+			// reads that were added from an earlier batch only add weight to the graph.
+			batch.setRepeated(i, !this->seen.insert(digest).second);
+		}
+	}
+
+	this->total += batch.size();
+}
+
+std::size_t
+ReadCollapser::reads() const {
+	return this->total;
+}
+
+std::size_t
+ReadCollapser::distinct() const {
+	return this->seen.size();
+}
+
+ReadCollapser::Digest
+ReadCollapser::canonical(const ReadBatch &batch, std::size_t read) {
+	uint64_t forwardFnv = FNV_OFFSET, forwardPoly = POLY_SEED;
+	uint64_t reverseFnv = FNV_OFFSET, reversePoly = POLY_SEED;
+	std::size_t segments = batch.segments(read);
+
+	for (std::size_t s = 0; s < segments; s++) {
+		extend(forwardFnv, forwardPoly, batch.segment(read, s));
+		// the reverse complement of a read has its segments in the opposite order.
+		extend(reverseFnv, reversePoly, batch.segmentReverseComplement(read, segments - s - 1));
+	}
+
+	Digest forward(qassembler::mix(forwardFnv), qassembler::mix(forwardPoly));
+	Digest reverse(qassembler::mix(reverseFnv), qassembler::mix(reversePoly));
+
+	return forward < reverse ? forward : reverse;
+}
+
+#endif // READ_COLLAPSER_CC
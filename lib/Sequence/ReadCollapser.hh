@@ -0,0 +1,65 @@
+/*
+ * File:   ReadCollapser.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_COLLAPSER_HH
+#define READ_COLLAPSER_HH
+
+#include <utility>
+#include <boost/cstdint.hpp>
+#include <boost/unordered_set.hpp>
+
+#include "Sequence/ReadBatch.hh"
+
+/**
+ * Collapse duplicate reads before they're added to the graph. Two reads are duplicates if they
+ * have the same segments, or if the segments of one are the reverse complements of the segments
+ * of the other. Within a batch, the first record of a read stands for all of its copies and the
+ * others stand for none; a read that was seen in an earlier batch is marked as repeated, so that
+ * only the weights of its copies are added to the graph. Reads are remembered by a 128-bit
+ * digest of their segments, so memory grows with the number of distinct reads, not their length.
+ */
+class ReadCollapser {
+public:
+	/** Constructor. */
+	ReadCollapser();
+
+	/**
+	 * Collapse the duplicate reads in a (normalised and filtered) batch.
+	 * @param batch the batch to collapse.
+	 */
+	void collapse(ReadBatch &batch);
+
+	/**
+	 * How many reads have been collapsed?
+	 * @return the number of reads in all of the batches collapsed so far.
+	 */
+	std::size_t reads() const;
+
+	/**
+	 * How many distinct reads have been seen?
+	 * @return the number of distinct reads in all of the batches collapsed so far.
+	 */
+	std::size_t distinct() const;
+private:
+	/** the digest of the segments of a read */
+	typedef std::pair<uint64_t, uint64_t> Digest;
+
+	/** the digests of every read seen so far (in their canonical orientation) */
+	boost::unordered_set<Digest> seen;
+	/** the number of reads collapsed so far */
+	std::size_t total;
+
+	/**
+	 * Compute the digest of the segments of a read in the orientation that has the smaller
+	 * digest, so that a read and its reverse complement have the same digest.
+	 * @param batch the batch that the read is in
+	 * @param read the index of the read in the batch
+	 * @return the digest.
+	 */
+	static Digest canonical(const ReadBatch &batch, std::size_t read);
+};
+
+#endif // READ_COLLAPSER_HH
@@ -0,0 +1,105 @@
+/*
+ * File:   ReadFilter.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_FILTER_CC
+#define READ_FILTER_CC
+
+#include "Sequence/ReadFilter.hh"
+
+/** fastq qualities are stored as Phred quality + 33 */
+#define PHRED_OFFSET 33
+
+ReadFilter::ReadFilter(std::size_t kmerLength, std::size_t minBaseQuality, std::size_t minKmerQuality, Ambiguity ambiguity) :
+		kmerLength(kmerLength), minBaseQuality(minBaseQuality), minKmerQuality(minKmerQuality), ambiguity(ambiguity) {}
+
+bool
+ReadFilter::enabled() const {
+	return minBaseQuality > 0 || minKmerQuality > 0 || ambiguity != KEEP_AMBIGUOUS;
+}
+
+bool
+ReadFilter::resolvesAmbiguity() const {
+	return ambiguity == RESOLVE_AMBIGUOUS;
+}
+
+char
+ReadFilter::resolve(char base) {
+	// complementary codes resolve to complementary bases, so both strands of a read resolve
+	// the same way. S and W are their own complements, so they can't be resolved.
+	switch (base) {
+		case 'R':
+			return 'A';
+		case 'Y':
+			return 'T';
+		case 'K':
+			return 'G';
+		case 'M':
+			return 'C';
+		default:
+			return base;
+	}
+}
+
+void
+ReadFilter::split(boost::string_ref sequence, boost::string_ref qual, std::vector<ReadSegment> &segments) const {
+	std::size_t length = sequence.size();
+	bool qualities = qual.size() == length && (minBaseQuality > 0 || minKmerQuality > 0);
+	bool ambiguous = ambiguity != KEEP_AMBIGUOUS;
+
+	if (!qualities && !ambiguous) {
+		segments.push_back(ReadSegment(0, length));
+		return;
+	}
+
+	// slide a window of k bases along the read, keeping the sum of the qualities in the window
+	// and the position just after the last base that can't be in an admitted k-mer.
+	std::size_t sum = 0;
+	std::size_t clean = 0;
+	std::size_t runStart = 0;
+	bool inRun = false;
+
+	for (std::size_t end = 0; end < length; end++) {
+		std::size_t q = qualities ? phred(qual[end]) : 0;
+		sum += q;
+		if ((qualities && q < minBaseQuality) || (ambiguous && !unambiguous(sequence[end]))) {
+			clean = end + 1;
+		}
+		if (end + 1 < kmerLength) {
+			continue;
+		}
+
+		std::size_t start = end + 1 - kmerLength;
+		if (start > 0 && qualities) {
+			sum -= phred(qual[start - 1]);
+		}
+
+		bool admitted = start >= clean && (!qualities || sum >= minKmerQuality * kmerLength);
+		if (admitted && !inRun) {
+			runStart = start;
+			inRun = true;
+		} else if (!admitted && inRun) {
+			// the last admitted window started just before this one.
+			segments.push_back(ReadSegment(runStart, start - 1 + kmerLength - runStart));
+			inRun = false;
+		}
+	}
+
+	if (inRun) {
+		segments.push_back(ReadSegment(runStart, length - runStart));
+	}
+}
+
+std::size_t
+ReadFilter::phred(char q) {
+	return q > PHRED_OFFSET ? q - PHRED_OFFSET : 0;
+}
+
+bool
+ReadFilter::unambiguous(char base) {
+	return base == 'A' || base == 'C' || base == 'G' || base == 'T';
+}
+
+#endif // READ_FILTER_CC
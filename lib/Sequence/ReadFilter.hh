@@ -0,0 +1,112 @@
+/*
+ * File:   ReadFilter.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_FILTER_HH
+#define READ_FILTER_HH
+
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * A part of a read that k-mers are taken from.
+ */
+struct ReadSegment {
+	ReadSegment(std::size_t start, std::size_t length) : start(start), length(length) {}
+	/** the position of the first base of the segment in the read */
+	std::size_t start;
+	/** the number of bases in the segment */
+	std::size_t length;
+};
+
+/**
+ * Decide which k-mers of a read are admitted to the graph. A k-mer (window) is admitted if none
+ * of its bases have a (Phred) quality lower than minBaseQuality, if the mean quality of its
+ * bases is at least minKmerQuality and (unless ambiguous bases are kept) if all of its bases
+ * are A, C, G or T. A read is split into the longest segments that only contain admitted
+ * k-mers; the k-mers between segments are dropped. Quality limits don't apply to reads
+ * without qualities (fasta reads).
+ */
+class ReadFilter {
+public:
+	/**
+	 * What to do with ambiguous (IUPAC) bases.
+	 */
+	enum Ambiguity {
+		/** keep k-mers with ambiguous bases */
+		KEEP_AMBIGUOUS,
+		/** drop k-mers with ambiguous bases */
+		SPLIT_AMBIGUOUS,
+		/** replace bases that are one of two bases (except S and W) with one of them, and
+		 * drop k-mers with any other ambiguous bases */
+		RESOLVE_AMBIGUOUS
+	};
+
+	/**
+	 * Constructor.
+	 * @param kmerLength the length of the k-mers that are taken from the reads
+	 * @param minBaseQuality the lowest quality a base in an admitted k-mer can have (0 for
+	 * no limit)
+	 * @param minKmerQuality the lowest mean quality of the bases in an admitted k-mer (0 for
+	 * no limit)
+	 * @param ambiguity what to do with ambiguous bases
+	 */
+	ReadFilter(std::size_t kmerLength, std::size_t minBaseQuality, std::size_t minKmerQuality,
+		   Ambiguity ambiguity = KEEP_AMBIGUOUS);
+
+	/**
+	 * Does this filter ever split a read?
+	 * @return true if any of the limits are set.
+	 */
+	bool enabled() const;
+
+	/**
+	 * Split a read into the segments that only contain admitted k-mers.
+	 * @param sequence the bases of the read
+	 * @param qual the qualities of the read (Phred+33, or empty if there are none)
+	 * @param segments the segments are appended here
+	 */
+	void split(boost::string_ref sequence, boost::string_ref qual, std::vector<ReadSegment> &segments) const;
+
+	/**
+	 * Should bases that are one of two bases be resolved before reads are split?
+	 * @return true if they should.
+	 */
+	bool resolvesAmbiguity() const;
+
+	/**
+	 * Resolve a base that is one of two bases to one of them: R to A, Y to T, K to G and M to C.
+	 * Complementary codes resolve to complementary bases, so a read and its reverse complement
+	 * resolve to the same k-mers. S and W are their own complements and aren't resolved.
+	 * @param base the (upper-case) base to resolve
+	 * @return the resolved base, or the same base if it can't be resolved.
+	 */
+	static char resolve(char base);
+private:
+	/** the length of the k-mers that are taken from the reads */
+	std::size_t kmerLength;
+	/** the lowest quality a base in an admitted k-mer can have */
+	std::size_t minBaseQuality;
+	/** the lowest mean quality of the bases in an admitted k-mer */
+	std::size_t minKmerQuality;
+	/** what to do with ambiguous bases */
+	Ambiguity ambiguity;
+
+	/**
+	 * The Phred quality of a quality character.
+	 * @param q the quality character
+	 * @return the quality.
+	 */
+	static std::size_t phred(char q);
+
+	/**
+	 * Is a base one of A, C, G or T?
+	 * @param base the (upper-case) base
+	 * @return true if the base isn't ambiguous.
+	 */
+	static bool unambiguous(char base);
+};
+
+#endif // READ_FILTER_HH
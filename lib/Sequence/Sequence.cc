@@ -34,56 +34,48 @@ Sequence::Sequence(std::string sequence, std::string name, std::string comment,
 
 void
 Sequence::revcom() {
+	reverse.clear();
+	reverse.reserve(sequence.size());
 	for (int i = sequence.size() - 1; i >= 0; i--) {
-		switch (sequence[i]) {
-			case 'T': case 't':
-				reverse += 'A';
-				break;
-			case 'G': case 'g':
-				reverse += 'C';
-				break;
-			case 'C': case 'c':
-				reverse += 'G';
-				break;
-			case 'A': case 'a':
-				reverse += 'T';
-				break;
-			case 'Y': case 'y':
-				reverse += 'R';
-				break;
-			case 'R': case 'r':
-				reverse += 'Y';
-				break;
-			case 'S': case 's':
-				reverse += 'S';
-				break;
-			case 'W': case 'w':
-				reverse += 'W';
-				break;
-			case 'M': case 'm':
-				reverse += 'K';
-				break;
-			case 'K': case 'k':
-				reverse += 'M';
-				break;
-			case 'V': case 'v':
-				reverse += 'B';
-				break;
-			case 'H': case 'h':
-				reverse += 'D';
-				break;
-			case 'D': case 'd':
-				reverse += 'H';
-				break;
-			case 'B': case 'b':
-				reverse += 'V';
-				break;
-			case 'N': case 'n':
-				reverse += 'N';
-				break;
-			default:
-				throw InvalidInputException ("Non-DNA input detected.");
-		}
+		reverse += complement(sequence[i]);
+	}
+}
+
+char
+Sequence::complement(char base) {
+	switch (base) {
+		case 'T': case 't':
+			return 'A';
+		case 'G': case 'g':
+			return 'C';
+		case 'C': case 'c':
+			return 'G';
+		case 'A': case 'a':
+			return 'T';
+		case 'Y': case 'y':
+			return 'R';
+		case 'R': case 'r':
+			return 'Y';
+		case 'S': case 's':
+			return 'S';
+		case 'W': case 'w':
+			return 'W';
+		case 'M': case 'm':
+			return 'K';
+		case 'K': case 'k':
+			return 'M';
+		case 'V': case 'v':
+			return 'B';
+		case 'H': case 'h':
+			return 'D';
+		case 'D': case 'd':
+			return 'H';
+		case 'B': case 'b':
+			return 'V';
+		case 'N': case 'n':
+			return 'N';
+		default:
+			throw InvalidInputException ("Non-DNA input detected.");
 	}
 }
 
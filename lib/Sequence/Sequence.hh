@@ -102,6 +102,14 @@ public:
 	 * @param id the new identifier for this read.
 	 */
 	void setID(std::size_t id);
+
+	/**
+	 * Get the complement of a base (or IUPAC ambiguity code).
+	 * @param base the base to complement (in either case).
+	 * @return the complement of the base, in upper case.
+	 * @throws InvalidInputException if base isn't a base or ambiguity code.
+	 */
+	static char complement(char base);
 private:
 	std::string sequence;
 	std::string reverse;
@@ -0,0 +1,90 @@
+/*
+ * File:   BoundedQueue.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BOUNDED_QUEUE_HH
+#define BOUNDED_QUEUE_HH
+
+#include <deque>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+/**
+ * A first-in, first-out queue with a fixed capacity that can be shared by several producer
+ * and consumer threads. Producers wait while the queue is full, and consumers wait while it
+ * is empty. Once a queue is closed, nothing more can be pushed, and consumers get whatever
+ * is left before being told that the queue is finished.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+	/**
+	 * Constructor.
+	 * @param capacity the maximum number of items in the queue (at least 1)
+	 */
+	BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1), closed(false) {}
+
+	/**
+	 * Add an item to the back of the queue, waiting until there's room for it.
+	 * @param item the item to add
+	 * @return false if the queue was closed (and the item was not added).
+	 */
+	bool push(const T &item) {
+		boost::unique_lock<boost::mutex> lock(this->mutex);
+		while (this->items.size() >= this->capacity && !this->closed) {
+			this->notFull.wait(lock);
+		}
+		if (this->closed) {
+			return false;
+		}
+		this->items.push_back(item);
+		this->notEmpty.notify_one();
+		return true;
+	}
+
+	/**
+	 * Take an item from the front of the queue, waiting until there is one.
+	 * @param item set to the item taken from the queue
+	 * @return false if the queue is closed and empty (and item was not set).
+	 */
+	bool pop(T &item) {
+		boost::unique_lock<boost::mutex> lock(this->mutex);
+		while (this->items.empty() && !this->closed) {
+			this->notEmpty.wait(lock);
+		}
+		if (this->items.empty()) {
+			return false;
+		}
+		item = this->items.front();
+		this->items.pop_front();
+		this->notFull.notify_one();
+		return true;
+	}
+
+	/**
+	 * Close the queue, waking any threads that are waiting on it.
+	 */
+	void close() {
+		boost::unique_lock<boost::mutex> lock(this->mutex);
+		this->closed = true;
+		this->notFull.notify_all();
+		this->notEmpty.notify_all();
+	}
+private:
+	/** the maximum number of items in the queue */
+	std::size_t capacity;
+	/** has the queue been closed? */
+	bool closed;
+	/** the items in the queue */
+	std::deque<T> items;
+	/** protects everything above */
+	boost::mutex mutex;
+	/** signalled when an item is taken from the queue */
+	boost::condition_variable notFull;
+	/** signalled when an item is added to the queue (or the queue is closed) */
+	boost::condition_variable notEmpty;
+};
+
+#endif // BOUNDED_QUEUE_HH
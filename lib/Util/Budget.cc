@@ -0,0 +1,31 @@
+/*
+ * File:   Budget.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BUDGET_CC
+#define BUDGET_CC
+
+#include "Util/Budget.hh"
+
+Budget::Budget(std::size_t maxItems, std::size_t maxMilliseconds) : maxItems(maxItems), timed(maxMilliseconds > 0) {
+	this->deadline = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(maxMilliseconds);
+}
+
+bool
+Budget::expired() const {
+	return this->timed && boost::posix_time::microsec_clock::universal_time() >= this->deadline;
+}
+
+bool
+Budget::full(std::size_t items) const {
+	return this->maxItems > 0 && items >= this->maxItems;
+}
+
+bool
+Budget::allows(std::size_t items) const {
+	return !full(items) && !expired();
+}
+
+#endif // BUDGET_CC
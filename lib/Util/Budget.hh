@@ -0,0 +1,56 @@
+/*
+ * File:   Budget.hh
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BUDGET_HH
+#define BUDGET_HH
+
+#include <cstddef>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+/**
+ * A limit on the amount of work spent on a single sub-graph. Work is limited by the number
+ * of items (e.g., paths) produced and by the wall time since the budget was created. Budgets
+ * are checked cooperatively by the code doing the work, and never change once created, so a
+ * budget can be checked from several threads at once.
+ */
+class Budget {
+public:
+	/**
+	 * Constructor. The clock starts when the budget is created.
+	 * @param maxItems the maximum number of items to produce (0 for no limit)
+	 * @param maxMilliseconds the maximum wall time to spend (0 for no limit)
+	 */
+	Budget(std::size_t maxItems, std::size_t maxMilliseconds);
+
+	/**
+	 * Has the time allowed by this budget run out?
+	 * @return true if the deadline has passed.
+	 */
+	bool expired() const;
+
+	/**
+	 * Has the item limit been reached?
+	 * @param items the number of items produced so far
+	 * @return true if no more items should be produced.
+	 */
+	bool full(std::size_t items) const;
+
+	/**
+	 * May more items be produced?
+	 * @param items the number of items produced so far
+	 * @return false if the item limit has been reached or the time has run out.
+	 */
+	bool allows(std::size_t items) const;
+private:
+	/** the maximum number of items to produce (0 for no limit) */
+	std::size_t maxItems;
+	/** is there a time limit? */
+	bool timed;
+	/** the time when this budget runs out */
+	boost::posix_time::ptime deadline;
+};
+
+#endif // BUDGET_HH
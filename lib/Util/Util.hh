@@ -16,6 +16,18 @@ namespace qassembler {
 		return boost::hash_value(value);
 	}
 
+	/** hash a range of characters, giving the same hash as a std::string with the same characters */
+	inline std::size_t hash(const char *begin, const char *end) {
+		return boost::hash_range(begin, end);
+	}
+
+	/** the splitmix64 finalizer, a bijective mixing function on 64-bit words */
+	inline uint64_t mix(uint64_t z) {
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
 } // namespace
 
 #endif
@@ -11,10 +11,12 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/progress.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 #include <cstdlib>
 #include <zlib.h>
 #include <stdio.h>
@@ -23,23 +25,45 @@
 
 #include "Graph/HeftyGraph.hh"
 #include "IO/GraphWriter.hh"
-#include "IO/FastaStream.hh"
+#include "IO/ReadPipeline.hh"
+#include "Sequence/ReadCollapser.hh"
+#include "Sequence/CoverageNormalizer.hh"
 #include "PreHash/PreHash.hh"
 #include "PathBuilder/Proportional/ProportionalPathBuilder.hh"
 #include "PathBuilder/Markov/MarkovPathBuilder.hh"
+#include "PathBuilder/Random/RandomPathBuilder.hh"
+#include "PathBuilder/Flow/FlowPathBuilder.hh"
+#include "PathBuilder/Beam/BeamPathBuilder.hh"
 #include "Abundance/MarkovAbundance/ForwardAlgorithmAbundance.hh"
 #include "Abundance/MarkovAbundance/MarkovChainAbundance.hh"
 #include "Sequence/Sequence.hh"
+#include "Sequence/ReadFilter.hh"
+#include "Util/Budget.hh"
 #include "Exception/KmerLengthException.hh"
 #include "QAssemblerParameterException.hh"
 
 #include "Logging/Logging.hh"
 
 /** input parameters */
-std::string inputSequences;
+std::vector<std::string> inputSequences;
+std::vector<std::string> mate1;
+std::vector<std::string> mate2;
+/** every input file, in the order that they're read */
+std::vector<std::string> inputFiles;
+std::size_t parserThreads = 1;
+std::size_t readBatchSize = 1024;
+std::size_t readQueueDepth = 16;
+std::size_t inflateThreads = 1;
 /** graph construction parameters */
 std::size_t kmerLength = 31;
+std::size_t minBaseQuality = 0;
+std::size_t minKmerQuality = 0;
+std::string ambiguousBases;
+/** splits reads into the segments that k-mers are taken from (NULL if reads aren't split) */
+boost::shared_ptr<ReadFilter> readFilter;
 bool preHash = false;
+bool collapseDuplicates = false;
+std::size_t normalizeCoverage = 0;
 HeftyGraph::TrackReads trackReads = HeftyGraph::DONT_TRACK_READS;
 /** graph modification parameters */
 std::size_t aggressiveLength = 0;
@@ -47,8 +71,15 @@ std::size_t aggressiveEdgeWeight = 0;
 /** sequence construction parameters */
 double epsilon = 0.1;
 std::string pathMethod = "proportional";
+std::size_t randomWalks = 1000;
+std::size_t randomSeed = 42;
+std::size_t threads = 1;
+std::size_t beamWidth = 16;
+std::size_t maxPathsPerGraph = 0;
+std::size_t maxPathMsPerGraph = 0;
 /** abundance estimation parameters */
-std::string abundanceMethod = "";
+std::size_t maxAbundanceMsPerGraph = 0;
+std::string abundanceMethod = "forward-algorithm";
 /** output parameters */
 bool printGraph = false;
 bool printSequences = false;
@@ -61,7 +92,8 @@ std::string graphDir = "./graphs";
 DECLARE_LOG(logger, "qassembler.QAssembler");
 
 int parseArgs(int, char**);
-boost::shared_ptr<HeftyGraph> buildGraph(boost::shared_ptr<PreHash>);
+boost::shared_ptr<HeftyGraph> buildGraph(boost::shared_ptr<PreHash>, std::size_t);
+void updateProgress(boost::progress_display &, std::size_t);
 
 int main(int argc, char **argv) {
 	if (parseArgs(argc, argv)) {
@@ -75,19 +107,23 @@ int main(int argc, char **argv) {
 
 	if (preHash) {
 		INFO(logger, "Pre-hashing reads.");
-		FastaStream fastaStream(inputSequences);
-		boost::progress_display progress(fastaStream.seqCount());
-		while (boost::shared_ptr<Sequence> read = fastaStream.nextSeq()) {
-			preHasher->addRead(read);
-			totalReadsProcessed++;
-			++progress;
+		ReadPipeline input(inputFiles, parserThreads, readBatchSize, readQueueDepth, inflateThreads, readFilter);
+		// the number of reads isn't known until the file has been read, so report progress
+		// through the (compressed) file instead.
+		boost::progress_display progress(input.size());
+		while (boost::shared_ptr<ReadBatch> batch = input.nextBatch()) {
+			preHasher->addReads(*batch);
+			totalReadsProcessed += batch->size();
+			updateProgress(progress, input.position());
 		}
+		updateProgress(progress, input.size());
 		INFO(logger, "Pre-hashed [" << totalReadsProcessed << "] reads.");
 	} else {
 		preHasher.reset();
 	}
 
-	boost::shared_ptr<HeftyGraph> g = buildGraph(preHasher);
+	// if the reads were pre-hashed, then we already know exactly how many reads there are.
+	boost::shared_ptr<HeftyGraph> g = buildGraph(preHasher, totalReadsProcessed);
 
 	if (aggressiveLength) {
 		INFO(logger, "Removing edges from all graphs with single nodes with length less than [" << aggressiveLength << "]");
@@ -102,8 +138,9 @@ int main(int argc, char **argv) {
 
 	if (printGraph) {
 		INFO(logger, "Writing graphs to files...");
-		std::set<boost::shared_ptr<SkinnyGraph> > graphs = g->getGraphs();
-		BOOST_FOREACH (boost::shared_ptr<SkinnyGraph> graph, graphs) {
+		const HeftyGraph::Graphs &graphs = g->getGraphs();
+		BOOST_FOREACH (const HeftyGraph::Graphs::value_type &entry, graphs) {
+			boost::shared_ptr<SkinnyGraph> graph = entry.second;
 			std::string filename = boost::lexical_cast<std::string>(graph->getId());
 		        filename += ".dot";
 			GraphWriter gw(graph, filename, graphDir);
@@ -115,59 +152,123 @@ int main(int argc, char **argv) {
 		boost::shared_ptr<Abundance> abundanceEstimator;
 
 		INFO(logger, "Generating sequences into directory [" << sequenceDir << "]");
-		std::set<boost::shared_ptr<SkinnyGraph> > graphs = g->getGraphs();
+		const HeftyGraph::Graphs &graphs = g->getGraphs();
 		boost::filesystem::create_directory(sequenceDir);
-		boost::unordered_map<boost::shared_ptr<SkinnyGraph>, boost::unordered_set<std::string> > paths;
-		//boost::unordered_set<std::string> paths;
 		std::size_t sequenceCount = 0;
 
 		boost::progress_display progress(graphs.size());
-		BOOST_FOREACH (boost::shared_ptr<SkinnyGraph> graph, graphs) {
+		BOOST_FOREACH (const HeftyGraph::Graphs::value_type &entry, graphs) {
+			boost::shared_ptr<SkinnyGraph> graph = entry.second;
 			DEBUG(logger, "Generating paths for graph [" << graph->getId() << "]");
 			boost::shared_ptr<PathBuilder> pathBuilder;
+			// the budget's clock starts before the path builder indexes the graph.
+			boost::shared_ptr<Budget> pathBudget;
+			if (maxPathsPerGraph || maxPathMsPerGraph) {
+				pathBudget = boost::make_shared<Budget>(maxPathsPerGraph, maxPathMsPerGraph);
+			}
+			boost::shared_ptr<FlowPathBuilder> flowBuilder;
+			boost::shared_ptr<RandomPathBuilder> randomBuilder;
+			boost::shared_ptr<BeamPathBuilder> beamBuilder;
 			if (pathMethod == "proportional") {
 				pathBuilder = boost::make_shared<ProportionalPathBuilder>(graph, epsilon);
 			} else if (pathMethod == "markov") {
 				pathBuilder = boost::make_shared<MarkovPathBuilder>(graph);
 			} else if (pathMethod == "random") {
-				throw QAssemblerParameterException ("random path builder is unimplemented.");
+				randomBuilder = boost::make_shared<RandomPathBuilder>(graph, randomWalks, threads, randomSeed);
+				pathBuilder = randomBuilder;
+			} else if (pathMethod == "flow") {
+				flowBuilder = boost::make_shared<FlowPathBuilder>(graph);
+				pathBuilder = flowBuilder;
+			} else if (pathMethod == "beam") {
+				beamBuilder = boost::make_shared<BeamPathBuilder>(graph, beamWidth);
+				pathBuilder = beamBuilder;
 			}
 			std::string filename = sequenceDir + "/" + boost::lexical_cast<std::string>(graph->getId()) + ".fna";
 			std::ofstream sequenceFile(filename.c_str());
+			boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+			if (pathBudget) {
+				pathBuilder->setBudget(pathBudget);
+			}
 			boost::unordered_set<PathBuilder::Path> paths = pathBuilder->buildPaths();
-			boost::unordered_map<std::string, double> abundances;
-			boost::unordered_set<std::string> sequencePaths;
-			BOOST_FOREACH (PathBuilder::Path p, paths) {
-				std::string sequence = p[0]->fullSequence();
+			boost::posix_time::time_duration pathTime = boost::posix_time::microsec_clock::universal_time() - start;
+			boost::unordered_map<PathBuilder::Path, double> abundances;
+			boost::unordered_map<PathBuilder::Path, std::size_t> flows;
+			boost::unordered_map<PathBuilder::Path, std::size_t> frequencies;
+			boost::unordered_map<PathBuilder::Path, double> scores;
+			if (flowBuilder) {
+				flows = flowBuilder->getPathFlows();
+			}
+			if (randomBuilder) {
+				frequencies = randomBuilder->getPathFrequencies();
+			}
+			if (beamBuilder) {
+				scores = beamBuilder->getPathScores();
+			}
+			// the builder's paths are already distinct, so short paths are dropped in place and
+			// sequences are only constructed for the paths that will be reported.
+			std::size_t builtPaths = paths.size();
+			for (boost::unordered_set<PathBuilder::Path>::iterator it = paths.begin(); it != paths.end();) {
+				const PathBuilder::Path &p = *it;
+				std::size_t length = p[0]->fullSequenceLength(kmerLength);
 				for (std::size_t i = 1; i < p.size(); i++) {
-					sequence += p[i]->sequence();
+					length += p[i]->kmerCount();
 				}
-				TRACE(logger, "Constructed sequence [" << sequence << "] for graph [" << graph->getId() << "].");
 				// don't bother reporting sequences less than k
-				if (sequence.size() > kmerLength && (!minimumLength || sequence.size() >= minimumLength)) {
-					sequencePaths.insert(sequence);
+				if (length > kmerLength && (!minimumLength || length >= minimumLength)) {
+					++it;
+				} else {
+					it = paths.erase(it);
 				}
 			}
 			graph->resetEdgeWeights();
-			if (abundanceMethod != "") {
+			start = boost::posix_time::microsec_clock::universal_time();
+			if (abundanceMethod != "none") {
 				if (abundanceMethod == "markov-chain") {
-					abundanceEstimator = boost::make_shared<MarkovChainAbundance>(g, sequencePaths);
+					abundanceEstimator = boost::make_shared<MarkovChainAbundance>(g, graph, paths);
 				} else if (abundanceMethod == "forward-algorithm") {
-					abundanceEstimator = boost::make_shared<ForwardAlgorithmAbundance>(g, sequencePaths);
+					abundanceEstimator = boost::make_shared<ForwardAlgorithmAbundance>(g, graph, paths);
 				}
 
-				abundances = abundanceEstimator->computeAbundances();
+				if (maxAbundanceMsPerGraph) {
+					abundanceEstimator->setBudget(boost::make_shared<Budget>(0, maxAbundanceMsPerGraph));
+				}
+				abundances = abundanceEstimator->computePathAbundances();
+			}
+			bool truncated = pathBuilder->truncated() || (abundanceEstimator && abundanceEstimator->truncated());
+			if (truncated) {
+				INFO(logger, "Graph [" << graph->getId() << "] ran out of budget, its sequences are marked as truncated.");
 			}
-			BOOST_FOREACH (std::string sequence, sequencePaths) {
+			boost::posix_time::time_duration abundanceTime = boost::posix_time::microsec_clock::universal_time() - start;
+			BOOST_FOREACH (const PathBuilder::Path &p, paths) {
+				std::string sequence = p[0]->fullSequence();
+				for (std::size_t i = 1; i < p.size(); i++) {
+					sequence += p[i]->sequence();
+				}
+				TRACE(logger, "Constructed sequence [" << sequence << "] for graph [" << graph->getId() << "].");
 				std::string abundance = "";
-				if (abundanceEstimator) {
-					abundance = " (" + abundanceMethod + ": " +
-						boost::lexical_cast<std::string>(abundances[sequence]) + ")";
+				if (flowBuilder) {
+					abundance += " (flow: " + boost::lexical_cast<std::string>(flows[p]) + ")";
+				}
+				if (randomBuilder) {
+					abundance += " (walks: " + boost::lexical_cast<std::string>(frequencies[p]) + ")";
+				}
+				if (beamBuilder) {
+					abundance += " (beam: " + boost::lexical_cast<std::string>(scores[p]) + ")";
+				}
+				// paths left over when the abundance budget ran out have no abundance.
+				if (abundanceEstimator && abundances.find(p) != abundances.end()) {
+					abundance += " (" + abundanceMethod + ": " +
+						boost::lexical_cast<std::string>(abundances[p]) + ")";
+				}
+				if (truncated) {
+					abundance += " (truncated)";
 				}
 				sequenceFile << ">" << ++sequenceCount << "(" << sequence.size() << "bp)" << abundance << std::endl;
 				sequenceFile << sequence << std::endl << std::endl;
 			}
-			INFO(logger, "Generated [" << paths.size() << "] sequences for graph [" << graph->getId() << "].");
+			INFO(logger, "Reported [" << paths.size() << "] sequences (from [" << builtPaths << "] paths) for graph [" << graph->getId() << "] (["
+			     << graph->numVertices() << "] vertices) in [" << pathTime.total_milliseconds() << "] ms, estimated abundances in ["
+			     << abundanceTime.total_milliseconds() << "] ms.");
 			++progress;
 		}
 	}
@@ -175,19 +276,44 @@ int main(int argc, char **argv) {
 	return 0;
 }
 
-boost::shared_ptr<HeftyGraph> buildGraph(boost::shared_ptr<PreHash> preHasher) {
-	std::size_t totalReadsProcessed = 1;
+void updateProgress(boost::progress_display &progress, std::size_t done) {
+	if (done > progress.count()) {
+		progress += done - progress.count();
+	}
+}
+
+boost::shared_ptr<HeftyGraph> buildGraph(boost::shared_ptr<PreHash> preHasher, std::size_t knownReads) {
+	std::size_t totalReadsProcessed = 0;
 	INFO(logger, "Constructing graph...");
 	boost::shared_ptr<HeftyGraph> g = boost::make_shared<HeftyGraph>(kmerLength, trackReads, preHasher, aggressiveEdgeWeight);
 	try {
-		FastaStream fastaStream(inputSequences);
-		boost::progress_display progress(fastaStream.seqCount());
-		while (boost::shared_ptr<Sequence> read = fastaStream.nextSeq()) {
-			if (read->getLength() >= kmerLength) {
-				g->addReadToGraph(read);
+		ReadPipeline input(inputFiles, parserThreads, readBatchSize, readQueueDepth, inflateThreads, readFilter);
+		ReadCollapser collapser;
+		// the sketches are only allocated if reads are normalised.
+		boost::shared_ptr<CoverageNormalizer> normalizer;
+		if (normalizeCoverage > 0) {
+			normalizer = boost::make_shared<CoverageNormalizer>(kmerLength, normalizeCoverage);
+		}
+		boost::progress_display progress(knownReads ? knownReads : input.size());
+		while (boost::shared_ptr<ReadBatch> batch = input.nextBatch()) {
+			if (collapseDuplicates) {
+				collapser.collapse(*batch);
 			}
-			totalReadsProcessed++;
-			++progress;
+			if (normalizer) {
+				normalizer->normalize(*batch);
+			}
+			g->addReadsToGraph(*batch);
+			totalReadsProcessed += batch->size();
+			updateProgress(progress, knownReads ? totalReadsProcessed : input.position());
+		}
+		updateProgress(progress, knownReads ? knownReads : input.size());
+		DEBUG(logger, "Added [" << totalReadsProcessed << "] reads to the graph.");
+		if (collapseDuplicates) {
+			INFO(logger, "Collapsed [" << collapser.reads() << "] reads into [" << collapser.distinct() << "] distinct reads.");
+		}
+		if (normalizer) {
+			INFO(logger, "Kept [" << normalizer->keptReads() << "] of [" << normalizer->reads() << "] reads at coverage [" << normalizeCoverage << "].");
+			g->rescaleWeights(*normalizer);
 		}
 	} catch (std::exception &e) {
 		FATAL(logger, e.what());
@@ -205,12 +331,34 @@ int parseArgs(int argc, char **argv) {
 	bool trackReadsBool = false;
 	desc.add_options()
 		("help,h", "list all options.")
-		("input-sequences,i", boost_po::value<std::string>(&inputSequences),
-		 	 "fasta/fastq file containing reads (required).")
+		("input-sequences,i", boost_po::value<std::vector<std::string> >(&inputSequences)->multitoken(),
+		 	 "fasta/fastq files containing reads (required unless mates are given).")
+		("mate1", boost_po::value<std::vector<std::string> >(&mate1)->multitoken(),
+		 	 "fasta/fastq files containing the first mates of paired-end reads.")
+		("mate2", boost_po::value<std::vector<std::string> >(&mate2)->multitoken(),
+		 	 "fasta/fastq files containing the second mates of paired-end reads (one for each mate1 file).")
+		("parser-threads", boost_po::value<std::size_t>(&parserThreads)->default_value(1),
+			 "number of threads used to parse reads while the graph is built (0 to parse on the reader thread).")
+		("read-batch-size", boost_po::value<std::size_t>(&readBatchSize)->default_value(1024),
+			 "number of reads passed between input threads at a time.")
+		("read-queue-depth", boost_po::value<std::size_t>(&readQueueDepth)->default_value(16),
+			 "maximum number of batches of reads that are read ahead of graph construction.")
+		("inflate-threads", boost_po::value<std::size_t>(&inflateThreads)->default_value(1),
+			 "number of threads used to decompress BGZF (bgzip) input (0 to decompress on the reader thread).")
 		("kmer-size,k", boost_po::value<std::size_t>(&kmerLength)->default_value(31),
 			 "set the k-mer size.")
+		("min-base-quality", boost_po::value<std::size_t>(&minBaseQuality)->default_value(0),
+			 "drop k-mers containing a base with a (Phred) quality below this (0 for no limit; fastq only).")
+		("min-kmer-quality", boost_po::value<std::size_t>(&minKmerQuality)->default_value(0),
+			 "drop k-mers whose mean (Phred) base quality is below this (0 for no limit; fastq only).")
+		("ambiguous-bases", boost_po::value<std::string>(&ambiguousBases)->default_value("keep"),
+			 "what to do with k-mers containing ambiguous (IUPAC) bases (one of keep, split or resolve).")
 		("pre-hash,p", boost_po::value<bool>(&preHash)->default_value(false)->zero_tokens(),
 		 	 "pre-hash the reads to guide graph construction.")
+		("collapse-duplicates", boost_po::value<bool>(&collapseDuplicates)->default_value(false)->zero_tokens(),
+		 	 "add the k-mers of identical (or reverse complemented) reads to the graph once, weighted by their number.")
+		("normalize-coverage", boost_po::value<std::size_t>(&normalizeCoverage)->default_value(0),
+		 	 "drop reads whose median k-mer abundance has reached this coverage (0 to keep all reads).")
 		("aggressive-edge-removal,a", boost_po::value<std::size_t>(&aggressiveEdgeWeight)->default_value(0),
 		 	 "remove edges from graphs where the edge weight is below a specified threshold.")
 		("print-graphs,g", boost_po::value<bool>(&printGraph)->default_value(false)->zero_tokens(),
@@ -224,13 +372,27 @@ int parseArgs(int argc, char **argv) {
 		("sequence-dir", boost_po::value<std::string>(&sequenceDir)->default_value("sequences"),
 		 	 "directory to dump reconstructed sequences.")
 		("path-method", boost_po::value<std::string>(&pathMethod)->default_value("proportional"),
-			 "method used to generate paths through the graph (one of proportional, markov or random)")
+			 "method used to generate paths through the graph (one of proportional, markov, random, flow or beam)")
+		("random-walks", boost_po::value<std::size_t>(&randomWalks)->default_value(1000),
+			 "number of random walks to take through each graph when path-method is random.")
+		("random-seed", boost_po::value<std::size_t>(&randomSeed)->default_value(42),
+			 "seed for the random walks when path-method is random.")
+		("threads,t", boost_po::value<std::size_t>(&threads)->default_value(1),
+			 "number of threads to use when taking random walks.")
+		("beam-width", boost_po::value<std::size_t>(&beamWidth)->default_value(16),
+			 "number of partial paths kept at each step when path-method is beam.")
+		("max-paths-per-graph", boost_po::value<std::size_t>(&maxPathsPerGraph)->default_value(0),
+			 "stop building paths through a graph after this many paths (0 for no limit).")
+		("max-path-ms-per-graph", boost_po::value<std::size_t>(&maxPathMsPerGraph)->default_value(0),
+			 "stop building paths through a graph after this many milliseconds (0 for no limit).")
 		("epsilon,e", boost_po::value<double>(&epsilon)->default_value(0.01),
 		 	 "allowable difference between paths during path generation.")
 		("minimum-length,l", boost_po::value<std::size_t>(&minimumLength)->default_value(0),
 		 	 "only report sequence longer than the specified length.")
-		("abundance-method", boost_po::value<std::string>(&abundanceMethod)->default_value(""),
-		 	 "the abundance estimation method (one of markov-chain or forward-algorithm)")
+		("abundance-method", boost_po::value<std::string>(&abundanceMethod)->default_value("forward-algorithm"),
+		 	 "the abundance estimation method (one of forward-algorithm, markov-chain or none)")
+		("max-abundance-ms-per-graph", boost_po::value<std::size_t>(&maxAbundanceMsPerGraph)->default_value(0),
+		 	 "stop estimating abundances for a graph after this many milliseconds (0 for no limit).")
 #ifdef USE_LOG4CXX
 		("log-config", boost_po::value<std::string>(&configFile)->default_value("log.config"),
 		 	 "location of config file for logging (log4cxx).")
@@ -256,16 +418,56 @@ int parseArgs(int argc, char **argv) {
 			throw KmerLengthException("k-mer length must be odd.");
 		}
 
-		if (inputSequences == "") {
-			throw QAssemblerParameterException("input-sequences is a required option.");
+		if (mate1.size() != mate2.size()) {
+			throw QAssemblerParameterException("mate1 and mate2 must be given the same number of files.");
+		}
+
+		// mates are read pair by pair after the unpaired reads; every file gets its own
+		// namespace of read identifiers, so the two mates of a pair don't clash.
+		inputFiles = inputSequences;
+		for (std::size_t i = 0; i < mate1.size(); i++) {
+			inputFiles.push_back(mate1[i]);
+			inputFiles.push_back(mate2[i]);
+		}
+
+		if (inputFiles.empty()) {
+			throw QAssemblerParameterException("input-sequences (or mate1 and mate2) is a required option.");
+		}
+
+		BOOST_FOREACH(std::string file, inputFiles) {
+			if (!boost::filesystem::exists(file)) {
+				throw QAssemblerParameterException("input file [" + file + "] doesn't exist.");
+			}
+		}
+
+		if (abundanceMethod == "") {
+			abundanceMethod = "none";
+		}
+
+		if (abundanceMethod != "none" && abundanceMethod != "markov-chain" && abundanceMethod != "forward-algorithm") {
+			throw QAssemblerParameterException("abundance method must be one of forward-algorithm, markov-chain or none");
+		}
+
+		if (pathMethod != "" && pathMethod != "proportional" && pathMethod != "markov" && pathMethod != "random" && pathMethod != "flow" && pathMethod != "beam") {
+			throw QAssemblerParameterException("path method must be one of proportional, markov, random, flow or beam");
+		}
+
+		if (beamWidth == 0) {
+			throw QAssemblerParameterException("beam-width must be greater than zero.");
 		}
 
-		if (abundanceMethod != "" && abundanceMethod != "markov-chain" && abundanceMethod != "forward-algorithm") {
-			throw QAssemblerParameterException("abundance method must be one of markov-chain or forward-algorithm");
+		ReadFilter::Ambiguity ambiguity = ReadFilter::KEEP_AMBIGUOUS;
+		if (ambiguousBases == "split") {
+			ambiguity = ReadFilter::SPLIT_AMBIGUOUS;
+		} else if (ambiguousBases == "resolve") {
+			ambiguity = ReadFilter::RESOLVE_AMBIGUOUS;
+		} else if (ambiguousBases != "" && ambiguousBases != "keep") {
+			throw QAssemblerParameterException("ambiguous-bases must be one of keep, split or resolve");
 		}
 
-		if (pathMethod != "" && pathMethod != "proportional" && pathMethod != "markov" && pathMethod != "random") {
-			throw QAssemblerParameterException("path method must be one of proportional, markov or random");
+		readFilter = boost::make_shared<ReadFilter>(kmerLength, minBaseQuality, minKmerQuality, ambiguity);
+		if (!readFilter->enabled()) {
+			readFilter.reset();
 		}
 	} catch (std::exception& e) {
 		std::cerr << e.what() << std::endl;
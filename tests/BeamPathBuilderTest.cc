@@ -0,0 +1,104 @@
+/*
+ * File:   BeamPathBuilderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BEAM_PATH_BUILDER_TEST_CC
+#define BEAM_PATH_BUILDER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+
+#include "PathBuilder/Beam/BeamPathBuilder.hh"
+
+struct BeamPathBuilderFixture {
+	BeamPathBuilderFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+		d = g->createSequenceNode(0x0045, 't', "read0004", 0x9004, 0, Kmer::FORWARD);
+	}
+
+	PathBuilder::Path path(SkinnyGraph::Vertex v1, SkinnyGraph::Vertex v2, SkinnyGraph::Vertex v3) {
+		PathBuilder::Path p;
+		p.push_back(g->node(v1));
+		p.push_back(g->node(v2));
+		p.push_back(g->node(v3));
+		return p;
+	}
+
+	void diamond() {
+		// a -> b -> d is seen 3 times, a -> c -> d once.
+		g->addEdge(a, b, boost::make_shared<WeightedEdge>(3));
+		g->addEdge(b, d, boost::make_shared<WeightedEdge>(3));
+		g->addEdge(a, c);
+		g->addEdge(c, d);
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c, d;
+};
+
+BOOST_FIXTURE_TEST_SUITE (beam_path_builder, BeamPathBuilderFixture)
+
+BOOST_AUTO_TEST_CASE (wide_beam) {
+	diamond();
+
+	BeamPathBuilder builder(g, 4);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+	boost::unordered_map<PathBuilder::Path, double> scores = builder.getPathScores();
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 2);
+	BOOST_REQUIRE_CLOSE(scores[path(a, b, d)], log(0.75), 1e-9);
+	BOOST_REQUIRE_CLOSE(scores[path(a, c, d)], log(0.25), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE (narrow_beam) {
+	diamond();
+
+	// only the most likely partial path survives each step.
+	BeamPathBuilder builder(g, 1);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 1);
+	BOOST_REQUIRE(paths.find(path(a, b, d)) != paths.end());
+}
+
+BOOST_AUTO_TEST_CASE (cycle) {
+	// a -> b -> c -> d, with b and c forming a cycle.
+	g->addEdge(a, b, boost::make_shared<WeightedEdge>(2));
+	g->addEdge(b, c, boost::make_shared<WeightedEdge>(4));
+	g->addEdge(c, b, boost::make_shared<WeightedEdge>(2));
+	g->addEdge(c, d, boost::make_shared<WeightedEdge>(2));
+
+	BeamPathBuilder builder(g, 4);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	// the search never returns to b, so the only path is a -> b -> c -> d.
+	PathBuilder::Path abcd = path(a, b, c);
+	abcd.push_back(g->node(d));
+	BOOST_REQUIRE_EQUAL(paths.size(), 1);
+	BOOST_REQUIRE(paths.find(abcd) != paths.end());
+	BOOST_REQUIRE_CLOSE(builder.getPathScores()[abcd], log(0.5), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE (isolated_vertex) {
+	BeamPathBuilder empty(boost::make_shared<SkinnyGraph>(2), 4);
+	BOOST_REQUIRE(empty.buildPaths().empty());
+
+	BeamPathBuilder builder(g, 4);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	// every vertex is a starting point and a path by itself.
+	BOOST_REQUIRE_EQUAL(paths.size(), 4);
+	BOOST_REQUIRE(paths.find(PathBuilder::Path(1, g->node(a))) != paths.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // BEAM_PATH_BUILDER_TEST_CC
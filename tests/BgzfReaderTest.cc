@@ -0,0 +1,168 @@
+/*
+ * File:   BgzfReaderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BGZF_READER_TEST_CC
+#define BGZF_READER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <zlib.h>
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include "IO/BgzfReader.hh"
+#include "IO/FastaStream.hh"
+#include "Exception/InvalidInputException.hh"
+
+#define READS 500
+/** how many bytes of the file go into each block */
+#define BLOCK 1000
+
+struct BgzfReaderFixture {
+	BgzfReaderFixture() : filename(boost::filesystem::unique_path("bgzf-reader-%%%%%%%%.fq.gz").string()) {
+		std::ostringstream out;
+		for (std::size_t i = 0; i < READS; i++) {
+			std::string bases = "ACGTACGTAC" + std::string(i % 13, 'G');
+			out << "@read" << i << std::endl << bases << std::endl << "+" << std::endl << std::string(bases.size(), 'I') << std::endl;
+		}
+		contents = out.str();
+	}
+
+	~BgzfReaderFixture() {
+		boost::filesystem::remove(filename);
+	}
+
+	/**
+	 * Write a little-endian integer.
+	 * @param out where to write the integer
+	 * @param value the integer
+	 * @param size the number of bytes to write
+	 */
+	void writeInt(std::ofstream &out, std::size_t value, std::size_t size) {
+		for (std::size_t i = 0; i < size; i++) {
+			out.put(static_cast<char>((value >> (8 * i)) & 0xff));
+		}
+	}
+
+	/**
+	 * Write a block the way bgzip does.
+	 * @param out where to write the block
+	 * @param data the bytes to compress into the block
+	 */
+	void writeBlock(std::ofstream &out, std::string data) {
+		std::vector<char> deflated(compressBound(data.size()) + 16);
+		z_stream stream = z_stream();
+		deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+		stream.avail_in = data.size();
+		stream.next_out = reinterpret_cast<Bytef*>(&deflated[0]);
+		stream.avail_out = deflated.size();
+		BOOST_REQUIRE_EQUAL(deflate(&stream, Z_FINISH), Z_STREAM_END);
+		std::size_t size = stream.total_out;
+		deflateEnd(&stream);
+
+		const char header[] = { '\x1f', '\x8b', 8, 4, 0, 0, 0, 0, 0, '\xff', 6, 0, 'B', 'C', 2, 0 };
+		out.write(header, sizeof(header));
+		writeInt(out, size + 25, 2);
+		out.write(&deflated[0], size);
+		writeInt(out, crc32(0L, reinterpret_cast<const Bytef*>(data.data()), data.size()), 4);
+		writeInt(out, data.size(), 4);
+	}
+
+	/**
+	 * Write the contents to the file as BGZF blocks, finishing with an empty block.
+	 */
+	void writeBgzf() {
+		std::ofstream out(filename.c_str(), std::ios::binary);
+		for (std::size_t i = 0; i < contents.size(); i += BLOCK) {
+			writeBlock(out, contents.substr(i, BLOCK));
+		}
+		writeBlock(out, "");
+	}
+
+	/**
+	 * Read all of the names in the file.
+	 * @param inflateThreads the number of threads that inflate the file
+	 * @return the names of the records, in order.
+	 */
+	std::vector<std::string> names(std::size_t inflateThreads) {
+		std::vector<std::string> names;
+		FastaStream stream(filename, inflateThreads);
+		while (boost::shared_ptr<ReadBatch> batch = stream.nextBatch(64)) {
+			batch->normalise();
+			for (std::size_t i = 0; i < batch->size(); i++) {
+				names.push_back(batch->name(i).to_string());
+			}
+		}
+		BOOST_REQUIRE_EQUAL(stream.position(), stream.size());
+		return names;
+	}
+
+	std::string filename;
+	std::string contents;
+};
+
+BOOST_FIXTURE_TEST_SUITE (bgzf_reader, BgzfReaderFixture)
+
+BOOST_AUTO_TEST_CASE (detect) {
+	writeBgzf();
+	BOOST_REQUIRE(BgzfReader::isBgzf(filename));
+
+	gzFile gz = gzopen(filename.c_str(), "w");
+	gzwrite(gz, contents.data(), contents.size());
+	gzclose(gz);
+	BOOST_REQUIRE(!BgzfReader::isBgzf(filename));
+
+	std::ofstream(filename.c_str()) << contents;
+	BOOST_REQUIRE(!BgzfReader::isBgzf(filename));
+}
+
+BOOST_AUTO_TEST_CASE (inflate) {
+	writeBgzf();
+
+	for (std::size_t threads = 1; threads <= 4; threads += 3) {
+		BgzfReader reader(filename, threads);
+		std::string inflated;
+		char buffer[777];
+		int n;
+		while ((n = reader.read(buffer, sizeof(buffer))) > 0) {
+			inflated.append(buffer, n);
+		}
+		BOOST_REQUIRE(inflated == contents);
+		BOOST_REQUIRE_EQUAL(reader.position(), boost::filesystem::file_size(filename));
+	}
+}
+
+BOOST_AUTO_TEST_CASE (same_as_zlib) {
+	writeBgzf();
+	std::vector<std::string> zlib = names(0);
+	std::vector<std::string> parallel = names(3);
+
+	BOOST_REQUIRE_EQUAL(zlib.size(), READS);
+	BOOST_REQUIRE_EQUAL_COLLECTIONS(zlib.begin(), zlib.end(), parallel.begin(), parallel.end());
+}
+
+BOOST_AUTO_TEST_CASE (corrupt) {
+	writeBgzf();
+	{
+		// flip a bit in the middle of the file.
+		std::fstream out(filename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+		out.seekp(boost::filesystem::file_size(filename) / 2);
+		out.put('\x5a');
+	}
+
+	BgzfReader reader(filename, 2);
+	char buffer[4096];
+	BOOST_REQUIRE_THROW(while (reader.read(buffer, sizeof(buffer)) > 0), InvalidInputException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // BGZF_READER_TEST_CC
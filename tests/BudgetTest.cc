@@ -0,0 +1,49 @@
+/*
+ * File:   BudgetTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef BUDGET_TEST_CC
+#define BUDGET_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include "Util/Budget.hh"
+
+BOOST_AUTO_TEST_SUITE (budget)
+
+BOOST_AUTO_TEST_CASE (unlimited) {
+	Budget budget(0, 0);
+
+	BOOST_REQUIRE(!budget.expired());
+	BOOST_REQUIRE(!budget.full(1000000));
+	BOOST_REQUIRE(budget.allows(1000000));
+}
+
+BOOST_AUTO_TEST_CASE (item_limit) {
+	Budget budget(2, 0);
+
+	BOOST_REQUIRE(budget.allows(0));
+	BOOST_REQUIRE(budget.allows(1));
+	BOOST_REQUIRE(budget.full(2));
+	BOOST_REQUIRE(!budget.allows(2));
+	BOOST_REQUIRE(!budget.expired());
+}
+
+BOOST_AUTO_TEST_CASE (time_limit) {
+	Budget budget(0, 10);
+
+	BOOST_REQUIRE(!budget.full(1000000));
+	boost::posix_time::ptime later = boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(20);
+	while (boost::posix_time::microsec_clock::universal_time() < later);
+	BOOST_REQUIRE(budget.expired());
+	BOOST_REQUIRE(!budget.allows(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // BUDGET_TEST_CC
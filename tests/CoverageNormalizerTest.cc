@@ -0,0 +1,112 @@
+/*
+ * File:   CoverageNormalizerTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef COVERAGE_NORMALIZER_TEST_CC
+#define COVERAGE_NORMALIZER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+
+#include "Sequence/CoverageNormalizer.hh"
+#include "Graph/HeftyGraph.hh"
+#include "Util/Util.hh"
+
+#define KMER_LENGTH 3
+#define COVERAGE 4
+#define DEPTH 10
+
+struct CoverageNormalizerFixture {
+	CoverageNormalizerFixture() : normalizer(KMER_LENGTH, COVERAGE) {
+		// none of the k-mers of the read are repeated on either strand.
+		for (std::size_t i = 0; i < DEPTH; i++) {
+			// reads with the same name would have the same identifier.
+			deep.add("AAACCC", std::string("deep") + static_cast<char>('0' + i), "", "");
+		}
+		deep.add("GATCAG", "shallow", "", "");
+		deep.normalise();
+	}
+
+	/**
+	 * Find the count of a k-mer in a graph.
+	 * @param g the graph to look in
+	 * @param kmer the k-mer to look for
+	 * @return the count of the k-mer (0 if it isn't in the graph).
+	 */
+	std::size_t count(HeftyGraph &g, std::string kmer) {
+		std::size_t hash = qassembler::hash(kmer);
+		BOOST_FOREACH (const HeftyGraph::Graphs::value_type &entry, g.getGraphs()) {
+			BOOST_FOREACH (SkinnyGraph::Vertex v, entry.second->getVertexIterators()) {
+				BOOST_FOREACH (boost::shared_ptr<Kmer> k, entry.second->node(v)->getKmers()) {
+					if (k->getHash() == hash) {
+						return k->getCount();
+					}
+				}
+			}
+		}
+		return 0;
+	}
+
+	ReadBatch deep;
+	CoverageNormalizer normalizer;
+};
+
+BOOST_FIXTURE_TEST_SUITE (coverage_normalizer, CoverageNormalizerFixture)
+
+BOOST_AUTO_TEST_CASE (normalize_batch) {
+	normalizer.normalize(deep);
+
+	// reads are kept until their median abundance reaches the target coverage.
+	for (std::size_t i = 0; i < DEPTH; i++) {
+		BOOST_REQUIRE_EQUAL(deep.copies(i), i < COVERAGE ? 1 : 0);
+	}
+	BOOST_REQUIRE_EQUAL(deep.copies(DEPTH), 1);
+
+	BOOST_REQUIRE_EQUAL(normalizer.reads(), DEPTH + 1);
+	BOOST_REQUIRE_EQUAL(normalizer.keptReads(), COVERAGE + 1);
+
+	// both strands are counted.
+	BOOST_REQUIRE_EQUAL(normalizer.observed(qassembler::hash("AAC")), DEPTH);
+	BOOST_REQUIRE_EQUAL(normalizer.observed(qassembler::hash("GTT")), DEPTH);
+	BOOST_REQUIRE_EQUAL(normalizer.kept(qassembler::hash("AAC")), COVERAGE);
+	BOOST_REQUIRE_CLOSE(normalizer.scale(qassembler::hash("AAC")), 2.5, 0.0001);
+	BOOST_REQUIRE_CLOSE(normalizer.scale(qassembler::hash("GAT")), 1.0, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE (normalize_copies) {
+	ReadBatch collapsed;
+	collapsed.add("AAACCC", "deep", "", "");
+	collapsed.normalise();
+	collapsed.setCopies(0, DEPTH);
+
+	normalizer.normalize(collapsed);
+
+	// only as many copies as it takes to reach the target coverage are kept.
+	BOOST_REQUIRE_EQUAL(collapsed.copies(0), COVERAGE);
+	BOOST_REQUIRE_EQUAL(normalizer.reads(), DEPTH);
+	BOOST_REQUIRE_EQUAL(normalizer.observed(qassembler::hash("AAC")), DEPTH);
+}
+
+BOOST_AUTO_TEST_CASE (rescale_weights) {
+	HeftyGraph g(KMER_LENGTH);
+
+	normalizer.normalize(deep);
+	g.addReadsToGraph(deep);
+
+	BOOST_REQUIRE_EQUAL(count(g, "AAC"), COVERAGE);
+	g.rescaleWeights(normalizer);
+
+	// the graph has the coverage of all of the reads again.
+	BOOST_REQUIRE_EQUAL(count(g, "AAC"), DEPTH);
+	BOOST_REQUIRE_EQUAL(count(g, "GTT"), DEPTH);
+	BOOST_REQUIRE_EQUAL(count(g, "GAT"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // COVERAGE_NORMALIZER_TEST_CC
@@ -0,0 +1,120 @@
+/*
+ * File:   EdgeSamplerTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef EDGE_SAMPLER_TEST_CC
+#define EDGE_SAMPLER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+
+#include "PathBuilder/Markov/EdgeSampler.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+struct EdgeSamplerFixture {
+	EdgeSamplerFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+
+		// a -> b has weight 1, a -> c has weight 3.
+		g->addEdge(a, b);
+		g->addEdge(a, c, boost::make_shared<WeightedEdge>(3));
+		ab = boost::edge(a, b, *g->graph()).first;
+		ac = boost::edge(a, c, *g->graph()).first;
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c;
+	SkinnyGraph::Edge ab, ac;
+};
+
+BOOST_FIXTURE_TEST_SUITE (edge_sampler, EdgeSamplerFixture)
+
+BOOST_AUTO_TEST_CASE (table) {
+	EdgeSampler sampler(g);
+	BOOST_REQUIRE(!sampler.cached(a));
+	const EdgeSampler::Table &t = sampler.table(a);
+
+	// edges are kept in out-edge order (which depends on where the vertices were allocated).
+	BOOST_REQUIRE(sampler.cached(a));
+	BOOST_REQUIRE_EQUAL(t.edges.size(), 2);
+	BOOST_REQUIRE(t.edges[0] != t.edges[1]);
+	for (std::size_t i = 0; i < t.edges.size(); i++) {
+		BOOST_REQUIRE(t.edges[i] == ab || t.edges[i] == ac);
+		BOOST_REQUIRE_EQUAL(t.weights[i], g->edge(t.edges[i])->getWeight());
+	}
+	BOOST_REQUIRE_EQUAL(t.total, 4);
+}
+
+BOOST_AUTO_TEST_CASE (sample) {
+	EdgeSampler sampler(g);
+	const EdgeSampler::Table &t = sampler.table(a);
+	// the share of the total weight taken by the first edge in the table.
+	double first = t.weights[0] / 4.;
+
+	BOOST_REQUIRE(sampler.sample(a, 0.) == t.edges[0]);
+	BOOST_REQUIRE(sampler.sample(a, first - 0.05) == t.edges[0]);
+	BOOST_REQUIRE(sampler.sample(a, first) == t.edges[1]);
+	BOOST_REQUIRE(sampler.sample(a, 0.99) == t.edges[1]);
+	BOOST_REQUIRE_THROW(sampler.sample(b, 0.5), InvalidGraphStateException);
+}
+
+BOOST_AUTO_TEST_CASE (update) {
+	EdgeSampler sampler(g);
+	const EdgeSampler::Table &t = sampler.table(a);
+	std::size_t sampled[2] = { 0, 0 };
+
+	// the table is only patched when told about the change.
+	g->edge(ac)->setWeight(1);
+	BOOST_REQUIRE_EQUAL(t.total, 4);
+
+	sampler.update(ac);
+	BOOST_REQUIRE_EQUAL(t.total, 2);
+	for (double u = 0.; u < 1.; u += 0.125) {
+		sampled[sampler.sample(a, u) == ab]++;
+	}
+	// both edges now have the same weight.
+	BOOST_REQUIRE_EQUAL(sampled[0], sampled[1]);
+
+	// consumed edges stay in the table, but are never selected.
+	g->edge(ab)->setWeight(0);
+	sampler.update(ab);
+	BOOST_REQUIRE_EQUAL(t.edges.size(), 2);
+	BOOST_REQUIRE(sampler.sample(a, 0.) == ac);
+	BOOST_REQUIRE(sampler.sample(a, 0.99) == ac);
+
+	// updating an edge whose source has no table does not build one.
+	g->addEdge(b, c);
+	sampler.update(boost::edge(b, c, *g->graph()).first);
+	BOOST_REQUIRE(!sampler.cached(b));
+}
+
+BOOST_AUTO_TEST_CASE (tables_survive_walks) {
+	EdgeSampler sampler(g);
+	const EdgeSampler::Table *before = &sampler.table(a);
+
+	// a walk follows a -> c and consumes two of its weight, the way MarkovPathBuilder does.
+	g->edge(ac)->decreaseWeight(2);
+	sampler.update(ac);
+
+	// the next walk reuses the same (patched) table.
+	BOOST_REQUIRE(sampler.cached(a));
+	BOOST_REQUIRE_EQUAL(&sampler.table(a), before);
+	BOOST_REQUIRE_EQUAL(before->total, 2);
+
+	// and a walk that consumes a -> c entirely leaves only a -> b to sample.
+	g->edge(ac)->decreaseWeight(1);
+	sampler.update(ac);
+	BOOST_REQUIRE_EQUAL(&sampler.table(a), before);
+	BOOST_REQUIRE(sampler.sample(a, 0.99) == ab);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // EDGE_SAMPLER_TEST_CC
@@ -0,0 +1,95 @@
+/*
+ * File:   FlowPathBuilderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef FLOW_PATH_BUILDER_TEST_CC
+#define FLOW_PATH_BUILDER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+
+#include "PathBuilder/Flow/FlowPathBuilder.hh"
+
+struct FlowPathBuilderFixture {
+	FlowPathBuilderFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+		d = g->createSequenceNode(0x0045, 't', "read0004", 0x9004, 0, Kmer::FORWARD);
+	}
+
+	PathBuilder::Path path(SkinnyGraph::Vertex v1, SkinnyGraph::Vertex v2, SkinnyGraph::Vertex v3) {
+		PathBuilder::Path p;
+		p.push_back(g->node(v1));
+		p.push_back(g->node(v2));
+		p.push_back(g->node(v3));
+		return p;
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c, d;
+};
+
+BOOST_FIXTURE_TEST_SUITE (flow_path_builder, FlowPathBuilderFixture)
+
+BOOST_AUTO_TEST_CASE (decompose_diamond) {
+	// a -> b -> d carries 3, a -> c -> d carries 1.
+	g->addEdge(a, b, boost::make_shared<WeightedEdge>(3));
+	g->addEdge(b, d, boost::make_shared<WeightedEdge>(3));
+	g->addEdge(a, c);
+	g->addEdge(c, d);
+
+	FlowPathBuilder builder(g);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+	boost::unordered_map<PathBuilder::Path, std::size_t> flows = builder.getPathFlows();
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 2);
+	BOOST_REQUIRE_EQUAL(flows[path(a, b, d)], 3);
+	BOOST_REQUIRE_EQUAL(flows[path(a, c, d)], 1);
+
+	// the weights in the graph are not consumed.
+	BOOST_REQUIRE_EQUAL(g->edge(boost::edge(a, b, *g->graph()).first)->getWeight(), 3);
+}
+
+BOOST_AUTO_TEST_CASE (isolated_vertex) {
+	FlowPathBuilder builder(boost::make_shared<SkinnyGraph>(2));
+	BOOST_REQUIRE(builder.buildPaths().empty());
+
+	// a vertex with no edges is a path by itself.
+	g->addEdge(b, c);
+	g->addEdge(c, d);
+	FlowPathBuilder single(g);
+	boost::unordered_set<PathBuilder::Path> paths = single.buildPaths();
+	PathBuilder::Path alone(1, g->node(a));
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 2);
+	BOOST_REQUIRE(paths.find(alone) != paths.end());
+	BOOST_REQUIRE_EQUAL(single.getPathFlows()[alone], 1);
+	BOOST_REQUIRE_EQUAL(single.getPathFlows()[path(b, c, d)], 1);
+}
+
+BOOST_AUTO_TEST_CASE (cycle) {
+	// a -> b -> c -> d, with b and c forming a cycle.
+	g->addEdge(a, b, boost::make_shared<WeightedEdge>(2));
+	g->addEdge(b, c, boost::make_shared<WeightedEdge>(4));
+	g->addEdge(c, b, boost::make_shared<WeightedEdge>(2));
+	g->addEdge(c, d, boost::make_shared<WeightedEdge>(2));
+
+	FlowPathBuilder builder(g);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	// the cycle can't be part of a path, so the only path is a -> b -> c -> d.
+	PathBuilder::Path abcd = path(a, b, c);
+	abcd.push_back(g->node(d));
+	BOOST_REQUIRE_EQUAL(paths.size(), 1);
+	BOOST_REQUIRE_EQUAL(builder.getPathFlows()[abcd], 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // FLOW_PATH_BUILDER_TEST_CC
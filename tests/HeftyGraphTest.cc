@@ -234,6 +234,7 @@ BOOST_AUTO_TEST_CASE (merge_graphs_and_nodes) {
 	boost::shared_ptr<SequenceNode> n = forward->node(v);
 	BOOST_TEST_CHECKPOINT("Checking that the forward sequence is correct");
 	BOOST_REQUIRE_EQUAL(n->fullSequence(), "AAAAACCCCC");
+	BOOST_REQUIRE_EQUAL(n->fullSequenceLength(5), 10);
 }
 
 BOOST_AUTO_TEST_CASE (add_edge_at_middle_of_dest) {
@@ -535,6 +536,64 @@ BOOST_AUTO_TEST_CASE (add_kmer_at_middle_of_source) {
 	BOOST_REQUIRE_EQUAL(edgePresent, true);
 }
 
+BOOST_AUTO_TEST_CASE (begin_state_transition_sum) {
+	HeftyGraph hg (3);
+
+	BOOST_REQUIRE_EQUAL(hg.getBeginStateTransitionSum(), 0);
+
+	BOOST_TEST_CHECKPOINT("Adding read1 to graph");
+	hg.addReadToGraph(read1);
+	// one vertex with no incoming edges in each of the forward and reverse graphs.
+	BOOST_REQUIRE_EQUAL(hg.getBeginStateTransitionSum(), 2);
+
+	BOOST_TEST_CHECKPOINT("Adding read4 to graph");
+	hg.addReadToGraph(read4);
+	// adding a read must invalidate the cached sum.
+	BOOST_REQUIRE_EQUAL(hg.getBeginStateTransitionSum(), 4);
+}
+
+BOOST_AUTO_TEST_CASE (live_graph_registry) {
+	HeftyGraph hg (3, HeftyGraph::TRACK_READS);
+
+	BOOST_TEST_CHECKPOINT("Adding distinct reads to graph");
+	hg.addReadToGraph(read1);
+	hg.addReadToGraph(read4);
+	BOOST_REQUIRE_EQUAL(hg.numGraphs(), 4);
+	BOOST_REQUIRE_EQUAL(hg.getGraphs().size(), 4);
+
+	// graphs should be ordered by their identifier and keyed by the same identifier.
+	std::size_t previous = 0;
+	bool first = true;
+	BOOST_FOREACH (const HeftyGraph::Graphs::value_type &entry, hg.getGraphs()) {
+		BOOST_REQUIRE_EQUAL(entry.first, entry.second->getId());
+		BOOST_REQUIRE(first || previous < entry.first);
+		previous = entry.first;
+		first = false;
+	}
+
+	// the graph that the read was placed in must be live.
+	boost::shared_ptr<SkinnyGraph> forward = hg.getForwardReads().get(0x9001);
+	BOOST_REQUIRE(hg.getGraphs().find(forward->getId()) != hg.getGraphs().end());
+	BOOST_REQUIRE(hg.getGraphs().find(forward->getId())->second == forward);
+
+	BOOST_TEST_CHECKPOINT("Merging graphs with an overlapping read");
+	hg.addReadToGraph(read3);
+	// read3 (CCTT) overlaps read1 and read4, so read1, read3 and read4 all share a graph.
+	BOOST_REQUIRE_EQUAL(hg.getGraphs().size(), hg.numGraphs());
+	forward = hg.getForwardReads().get(0x0043);
+	BOOST_REQUIRE(hg.getGraphs().find(forward->getId()) != hg.getGraphs().end());
+
+	BOOST_TEST_CHECKPOINT("Removing short graphs");
+	HeftyGraph shortGraphs (3);
+	shortGraphs.addReadToGraph(read1);
+	BOOST_REQUIRE_EQUAL(shortGraphs.numGraphs(), 2);
+	// each graph is a single node with 4 nucleotides.
+	shortGraphs.removeGraphsShorterThan(4);
+	BOOST_REQUIRE_EQUAL(shortGraphs.numGraphs(), 2);
+	shortGraphs.removeGraphsShorterThan(6);
+	BOOST_REQUIRE_EQUAL(shortGraphs.numGraphs(), 0);
+	BOOST_REQUIRE(shortGraphs.getGraphs().empty());
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
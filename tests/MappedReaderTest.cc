@@ -0,0 +1,164 @@
+/*
+ * File:   MappedReaderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef MAPPED_READER_TEST_CC
+#define MAPPED_READER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <fstream>
+#include <vector>
+#include <zlib.h>
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include "IO/FastaStream.hh"
+#include "IO/MappedReader.hh"
+#include "Exception/InvalidInputException.hh"
+
+/** a fasta file with blank lines and sequences spanning several lines */
+#define FASTA ">one first comment\nACGT\nacgt\n\n>two\nGGGG\n>three  spaced\nT\nT\nT\n"
+/** a fastq file where qualities start with '@' and '+', and span several lines */
+#define FASTQ "@one comment\nACGTACGT\n+\n@III+III\n@two\nGG\nGG\n+two\nII\n+I\n@three\nA\n+\n@\n"
+
+struct MappedReaderFixture {
+	MappedReaderFixture() : plain(boost::filesystem::unique_path("mapped-reader-%%%%%%%%.txt").string()),
+			compressed(plain + ".gz") {}
+
+	~MappedReaderFixture() {
+		boost::filesystem::remove(plain);
+		boost::filesystem::remove(compressed);
+	}
+
+	/**
+	 * Write the same contents to a plain and a gzip-compressed file.
+	 * @param contents what to write
+	 */
+	void write(std::string contents) {
+		std::ofstream out(plain.c_str());
+		out << contents;
+		out.close();
+
+		gzFile gz = gzopen(compressed.c_str(), "w");
+		gzwrite(gz, contents.data(), contents.size());
+		gzclose(gz);
+	}
+
+	/**
+	 * Read every record in a file.
+	 * @param filename the file to read
+	 * @return the sequence, name, comment and qualities of each record, one after the other.
+	 */
+	std::vector<std::string> readAll(std::string filename) {
+		std::vector<std::string> parts;
+		std::string sequence, name, comment, qual;
+		FastaStream stream(filename);
+
+		while (stream.nextRecord(sequence, name, comment, qual)) {
+			parts.push_back(sequence);
+			parts.push_back(name);
+			parts.push_back(comment);
+			parts.push_back(qual);
+		}
+
+		return parts;
+	}
+
+	/**
+	 * Check that the mapped reader finds exactly the same records as kseq.
+	 * @param contents the file contents to check
+	 */
+	void checkSameAsKseq(std::string contents) {
+		write(contents);
+		BOOST_REQUIRE(FastaStream(plain).isMapped());
+		BOOST_REQUIRE(!FastaStream(compressed).isMapped());
+
+		std::vector<std::string> mapped = readAll(plain);
+		std::vector<std::string> kseq = readAll(compressed);
+		BOOST_REQUIRE_EQUAL(mapped.size(), 12);
+		BOOST_REQUIRE_EQUAL_COLLECTIONS(mapped.begin(), mapped.end(), kseq.begin(), kseq.end());
+	}
+
+	std::string plain;
+	std::string compressed;
+};
+
+BOOST_FIXTURE_TEST_SUITE (mapped_reader, MappedReaderFixture)
+
+BOOST_AUTO_TEST_CASE (fasta) {
+	checkSameAsKseq(FASTA);
+	std::vector<std::string> parts = readAll(plain);
+	BOOST_REQUIRE_EQUAL(parts[0], "ACGTacgt");
+	BOOST_REQUIRE_EQUAL(parts[2], "first comment");
+	BOOST_REQUIRE_EQUAL(parts[8], "TTT");
+	BOOST_REQUIRE_EQUAL(parts[10], " spaced");
+}
+
+BOOST_AUTO_TEST_CASE (fastq) {
+	checkSameAsKseq(FASTQ);
+	std::vector<std::string> parts = readAll(plain);
+	BOOST_REQUIRE_EQUAL(parts[3], "@III+III");
+	BOOST_REQUIRE_EQUAL(parts[4], "GGGG");
+	BOOST_REQUIRE_EQUAL(parts[7], "II+I");
+}
+
+BOOST_AUTO_TEST_CASE (carriage_returns) {
+	write(">one\r\nACGT\r\nAC\r\n>two\r\nT\r\n");
+	std::vector<std::string> parts = readAll(plain);
+	BOOST_REQUIRE_EQUAL(parts.size(), 8);
+	BOOST_REQUIRE_EQUAL(parts[0], "ACGTAC");
+	BOOST_REQUIRE_EQUAL(parts[1], "one");
+	BOOST_REQUIRE_EQUAL(parts[4], "T");
+}
+
+BOOST_AUTO_TEST_CASE (short_qualities) {
+	write("@one\nACGT\n+\nII\n");
+	FastaStream stream(plain);
+	BOOST_REQUIRE_THROW(stream.nextBatch(10), InvalidInputException);
+}
+
+BOOST_AUTO_TEST_CASE (ranges) {
+	// cutting the file into ranges and reading each range on its own finds the same records as
+	// reading the whole file.
+	write(FASTQ);
+	std::vector<std::string> whole = readAll(plain);
+
+	for (std::size_t n = 1; n <= 3; n++) {
+		FastaStream stream(plain);
+		std::vector<std::string> names;
+		std::size_t begin, end, last = 0;
+
+		while (stream.nextRange(n, begin, end)) {
+			BOOST_REQUIRE_EQUAL(begin, last);
+			last = end;
+
+			boost::shared_ptr<ReadBatch> batch = stream.readRange(begin, end);
+			BOOST_REQUIRE(batch->size() <= n);
+			batch->normalise();
+			for (std::size_t i = 0; i < batch->size(); i++) {
+				names.push_back(batch->name(i).to_string());
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(last, stream.size());
+		BOOST_REQUIRE_EQUAL(names.size(), 3);
+		BOOST_REQUIRE_EQUAL(names[0], whole[1]);
+		BOOST_REQUIRE_EQUAL(names[1], whole[5]);
+		BOOST_REQUIRE_EQUAL(names[2], whole[9]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE (unmapped_ranges) {
+	write(FASTA);
+	FastaStream stream(compressed);
+	std::size_t begin, end;
+	BOOST_REQUIRE_THROW(stream.nextRange(1, begin, end), InvalidInputException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // MAPPED_READER_TEST_CC
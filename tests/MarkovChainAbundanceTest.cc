@@ -0,0 +1,99 @@
+/*
+ * File:   MarkovChainAbundanceTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef MARKOV_CHAIN_ABUNDANCE_TEST_CC
+#define MARKOV_CHAIN_ABUNDANCE_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/foreach.hpp>
+#include <cmath>
+
+#include "Abundance/MarkovAbundance/MarkovChainAbundance.hh"
+
+#define KMER_LENGTH 5
+
+struct MarkovChainAbundanceFixture {
+	MarkovChainAbundanceFixture() : g(boost::make_shared<HeftyGraph>(KMER_LENGTH)) {
+		ReadBatch batch;
+		// the reads share their first 8 bases, then branch. the reverse complements of the
+		// reads share no k-mers with the reads, so they're in a graph of their own.
+		batch.add("CCGTAATGACCTTTC", "first", "", "");
+		batch.add("CCGTAATGACCTTTC", "second", "", "");
+		batch.add("CCGTAATGCCCTAAC", "third", "", "");
+		batch.normalise();
+		g->addReadsToGraph(batch);
+
+		// find the graph where the shared vertex branches.
+		BOOST_FOREACH (const HeftyGraph::Graphs::value_type &entry, g->getGraphs()) {
+			BOOST_FOREACH (SkinnyGraph::Vertex v, entry.second->getVertexIterators()) {
+				if (boost::out_degree(v, *entry.second->graph()) == 2) {
+					forward = entry.second;
+					shared = v;
+				}
+			}
+		}
+		BOOST_REQUIRE(forward);
+		BOOST_REQUIRE_EQUAL(forward->numVertices(), 3);
+
+		// give the branches known weights: 3 to the first, 1 to the second.
+		BOOST_FOREACH (SkinnyGraph::Edge e, boost::out_edges(shared, *forward->graph())) {
+			SkinnyGraph::Vertex target = boost::target(e, *forward->graph());
+			PathBuilder::Path path;
+			path.push_back(forward->node(shared));
+			path.push_back(forward->node(target));
+
+			if (forward->node(target)->sequence()[0] == 'A') {
+				forward->edge(e)->setWeight(3);
+				first = path;
+			} else {
+				forward->edge(e)->setWeight(1);
+				second = path;
+			}
+		}
+	}
+
+	boost::shared_ptr<HeftyGraph> g;
+	boost::shared_ptr<SkinnyGraph> forward;
+	SkinnyGraph::Vertex shared;
+	PathBuilder::Path first, second;
+};
+
+BOOST_FIXTURE_TEST_SUITE (markov_chain_abundance, MarkovChainAbundanceFixture)
+
+BOOST_AUTO_TEST_CASE (path_abundances) {
+	boost::unordered_set<PathBuilder::Path> paths;
+	paths.insert(first);
+	paths.insert(second);
+
+	MarkovChainAbundance abundance(g, forward, paths);
+	boost::unordered_map<PathBuilder::Path, double> abundances = abundance.computePathAbundances();
+
+	// the first k-mer of the shared vertex was seen in all 3 reads. the vertices without
+	// incoming edges are the shared vertex (3) and the two ends of the reverse complements
+	// (2 and 1), so the path starts in the shared vertex with probability 3 / 6.
+	BOOST_REQUIRE_EQUAL(abundances.size(), 2);
+	BOOST_REQUIRE_CLOSE(abundances[first], log(3. / 6.) + log(3. / 4.), 1e-9);
+	BOOST_REQUIRE_CLOSE(abundances[second], log(3. / 6.) + log(1. / 4.), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE (single_vertex_path) {
+	boost::unordered_set<PathBuilder::Path> paths;
+	PathBuilder::Path start(1, forward->node(shared));
+	paths.insert(start);
+
+	MarkovChainAbundance abundance(g, forward, paths);
+	boost::unordered_map<PathBuilder::Path, double> abundances = abundance.computePathAbundances();
+
+	BOOST_REQUIRE_CLOSE(abundances[start], log(3. / 6.), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // MARKOV_CHAIN_ABUNDANCE_TEST_CC
@@ -0,0 +1,69 @@
+/*
+ * File:   MarkovPathBuilderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef MARKOV_PATH_BUILDER_TEST_CC
+#define MARKOV_PATH_BUILDER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+
+#include "PathBuilder/Markov/MarkovPathBuilder.hh"
+
+struct MarkovPathBuilderFixture {
+	MarkovPathBuilderFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+
+		abc.push_back(g->node(a));
+		abc.push_back(g->node(b));
+		abc.push_back(g->node(c));
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c;
+	PathBuilder::Path abc;
+};
+
+BOOST_FIXTURE_TEST_SUITE (markov_path_builder, MarkovPathBuilderFixture)
+
+BOOST_AUTO_TEST_CASE (light_edge_does_not_wrap) {
+	// a -> b has weight 1, b -> c has weight 5.
+	g->addEdge(a, b);
+	g->addEdge(b, c, boost::make_shared<WeightedEdge>(5));
+	g->lockEdgeWeights();
+
+	MarkovPathBuilder builder(g);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 1);
+	BOOST_REQUIRE(paths.find(abc) != paths.end());
+	// both edges are consumed, a -> b is not wrapped around to a huge weight.
+	BOOST_REQUIRE_EQUAL(g->edge(boost::edge(a, b, *g->graph()).first)->getWeight(), 0);
+	BOOST_REQUIRE_EQUAL(g->edge(boost::edge(b, c, *g->graph()).first)->getWeight(), 0);
+}
+
+BOOST_AUTO_TEST_CASE (unit_weights_are_consumed) {
+	// every edge has weight 1, so no edge sets the amount to consume.
+	g->addEdge(a, b);
+	g->addEdge(b, c);
+	g->lockEdgeWeights();
+
+	MarkovPathBuilder builder(g);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 1);
+	BOOST_REQUIRE(paths.find(abc) != paths.end());
+	BOOST_REQUIRE_EQUAL(g->edge(boost::edge(a, b, *g->graph()).first)->getWeight(), 0);
+	BOOST_REQUIRE_EQUAL(g->edge(boost::edge(b, c, *g->graph()).first)->getWeight(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // MARKOV_PATH_BUILDER_TEST_CC
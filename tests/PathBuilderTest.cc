@@ -0,0 +1,93 @@
+/*
+ * File:   PathBuilderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef PATH_BUILDER_TEST_CC
+#define PATH_BUILDER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/foreach.hpp>
+
+#include "PathBuilder/PathBuilder.hh"
+
+// expose the edge selection primitives that path builders share.
+class EdgePathBuilder : public PathBuilder {
+public:
+	EdgePathBuilder(boost::shared_ptr<SkinnyGraph> graph) : PathBuilder(graph) {}
+	boost::unordered_set<Path> buildPaths() { return boost::unordered_set<Path>(); }
+
+	using PathBuilder::getOutgoingEdges;
+	using PathBuilder::outDegree;
+	using PathBuilder::inDegree;
+	using PathBuilder::pickNextEdge;
+	using PathBuilder::decreaseEdgeWeight;
+	using PathBuilder::setEdgeWeight;
+};
+
+struct PathBuilderFixture {
+	PathBuilderFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+
+		// a -> b has weight 1, a -> c has weight 3.
+		g->addEdge(a, b);
+		g->addEdge(a, c, boost::make_shared<WeightedEdge>(3));
+		g->lockEdgeWeights();
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c;
+};
+
+BOOST_FIXTURE_TEST_SUITE (path_builder, PathBuilderFixture)
+
+BOOST_AUTO_TEST_CASE (live_degrees) {
+	EdgePathBuilder builder(g);
+
+	BOOST_REQUIRE_EQUAL(builder.outDegree(a), 2);
+	BOOST_REQUIRE_EQUAL(builder.inDegree(b), 1);
+	BOOST_REQUIRE_EQUAL(builder.outDegree(b), 0);
+
+	// consuming a -> b removes it from the live edges.
+	SkinnyGraph::Edge ab = boost::edge(a, b, *g->graph()).first;
+	builder.decreaseEdgeWeight(ab, 1);
+	BOOST_REQUIRE_EQUAL(builder.outDegree(a), 1);
+	BOOST_REQUIRE_EQUAL(builder.inDegree(b), 0);
+
+	std::size_t live = 0;
+	BOOST_FOREACH (SkinnyGraph::Edge e, builder.getOutgoingEdges(a)) {
+		BOOST_REQUIRE(boost::target(e, *g->graph()) == c);
+		live++;
+	}
+	BOOST_REQUIRE_EQUAL(live, 1);
+
+	// restoring the weight brings the edge back.
+	builder.setEdgeWeight(ab, 2);
+	BOOST_REQUIRE_EQUAL(builder.outDegree(a), 2);
+	BOOST_REQUIRE_EQUAL(builder.inDegree(b), 1);
+}
+
+BOOST_AUTO_TEST_CASE (pick_next_edge) {
+	EdgePathBuilder builder(g);
+
+	const PathBuilder::EdgeChoice &choice = builder.pickNextEdge(a, 0.25, 0.05);
+	BOOST_REQUIRE_EQUAL(choice.edges.size(), 2);
+	BOOST_REQUIRE_EQUAL(choice.sum, 4.);
+	BOOST_REQUIRE(boost::target(choice.edges[choice.max].first, *g->graph()) == c);
+	BOOST_REQUIRE(choice.found);
+	BOOST_REQUIRE(boost::target(choice.edges[choice.closest].first, *g->graph()) == b);
+
+	builder.pickNextEdge(a, 0.5, 0.05);
+	BOOST_REQUIRE(!choice.found);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // PATH_BUILDER_TEST_CC
@@ -0,0 +1,89 @@
+/*
+ * File:   PathTrieTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef PATH_TRIE_TEST_CC
+#define PATH_TRIE_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <cmath>
+
+#include "Abundance/MarkovAbundance/PathTrie.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+struct PathTrieFixture {
+	PathTrieFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+
+		// a -> b has weight 1, a -> c has weight 3.
+		g->addEdge(a, b);
+		g->addEdge(a, c, boost::make_shared<WeightedEdge>(3));
+
+		table = boost::make_shared<TransitionTable>(g, 4);
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	boost::shared_ptr<TransitionTable> table;
+	SkinnyGraph::Vertex a, b, c;
+};
+
+BOOST_FIXTURE_TEST_SUITE (path_trie, PathTrieFixture)
+
+BOOST_AUTO_TEST_CASE (shared_prefix) {
+	PathTrie trie(table);
+	std::vector<SkinnyGraph::Vertex> ab, ac;
+	ab.push_back(a);
+	ab.push_back(b);
+	ac.push_back(a);
+	ac.push_back(c);
+
+	std::size_t endB = trie.insert(ab);
+	std::size_t endC = trie.insert(ac);
+
+	// both paths share the root node for a.
+	BOOST_REQUIRE_EQUAL(trie.numNodes(), 3);
+	BOOST_REQUIRE_EQUAL(trie.numInsertedVertices(), 4);
+	BOOST_REQUIRE_NE(endB, endC);
+	// inserting the same path again reuses the existing nodes.
+	BOOST_REQUIRE_EQUAL(trie.insert(ab), endB);
+	BOOST_REQUIRE_EQUAL(trie.numNodes(), 3);
+}
+
+BOOST_AUTO_TEST_CASE (evaluate) {
+	PathTrie trie(table);
+	std::vector<SkinnyGraph::Vertex> path;
+	path.push_back(a);
+	std::size_t root = trie.insert(path);
+	path.push_back(c);
+	std::size_t end = trie.insert(path);
+
+	std::vector<double> initial(table->numVertices(), 0.);
+	initial[table->vertexIndex(a)] = log(0.5);
+	std::vector<double> scores = trie.evaluate(initial);
+
+	BOOST_REQUIRE_CLOSE(scores[root], log(0.5), 1e-9);
+	BOOST_REQUIRE_CLOSE(scores[end], log(0.5) + log(0.75), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE (invalid_paths) {
+	PathTrie trie(table);
+	std::vector<SkinnyGraph::Vertex> path;
+
+	BOOST_REQUIRE_THROW(trie.insert(path), InvalidGraphStateException);
+
+	path.push_back(b);
+	path.push_back(c);
+	BOOST_REQUIRE_THROW(trie.insert(path), InvalidGraphStateException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // PATH_TRIE_TEST_CC
@@ -0,0 +1,112 @@
+/*
+ * File:   ProportionalPathBuilderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef PROPORTIONAL_PATH_BUILDER_TEST_CC
+#define PROPORTIONAL_PATH_BUILDER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/foreach.hpp>
+
+#include "PathBuilder/Proportional/ProportionalPathBuilder.hh"
+
+struct ProportionalPathBuilderFixture {
+	ProportionalPathBuilderFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+		d = g->createSequenceNode(0x0045, 't', "read0004", 0x9004, 0, Kmer::FORWARD);
+	}
+
+	PathBuilder::Path path(SkinnyGraph::Vertex v1, SkinnyGraph::Vertex v2, SkinnyGraph::Vertex v3) {
+		PathBuilder::Path p;
+		p.push_back(g->node(v1));
+		p.push_back(g->node(v2));
+		p.push_back(g->node(v3));
+		return p;
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c, d;
+};
+
+BOOST_FIXTURE_TEST_SUITE (proportional_path_builder, ProportionalPathBuilderFixture)
+
+BOOST_AUTO_TEST_CASE (acyclic_graph) {
+	// a -> b -> d and a -> c -> d, where a -> b is the heavier branch.
+	g->addEdge(a, b, boost::make_shared<WeightedEdge>(3));
+	g->addEdge(a, c);
+	g->addEdge(b, d);
+	g->addEdge(c, d);
+	g->lockEdgeWeights();
+
+	boost::unordered_set<PathBuilder::Path> paths;
+	{
+		ProportionalPathBuilder builder(g, 0.01);
+		paths = builder.buildPaths();
+	}
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 2);
+	BOOST_REQUIRE(paths.find(path(a, b, d)) != paths.end());
+	BOOST_REQUIRE(paths.find(path(a, c, d)) != paths.end());
+
+	// the builder restores the edge weights when it is finished.
+	BOOST_REQUIRE_EQUAL(g->edge(boost::edge(a, b, *g->graph()).first)->getWeight(), 3);
+}
+
+BOOST_AUTO_TEST_CASE (cyclic_graph) {
+	// a -> b -> c -> d, with b and c forming a cycle.
+	g->addEdge(a, b);
+	g->addEdge(b, c);
+	g->addEdge(c, b);
+	g->addEdge(c, d);
+	g->lockEdgeWeights();
+
+	ProportionalPathBuilder builder(g, 0.01);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	BOOST_REQUIRE(!paths.empty());
+	BOOST_FOREACH (const PathBuilder::Path &p, paths) {
+		// every path starts at a and never visits a vertex twice.
+		BOOST_REQUIRE(p.front() == g->node(a));
+		for (std::size_t i = 0; i < p.size(); i++) {
+			for (std::size_t j = i + 1; j < p.size(); j++) {
+				BOOST_REQUIRE(p[i] != p[j]);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE (path_budget) {
+	g->addEdge(a, b, boost::make_shared<WeightedEdge>(3));
+	g->addEdge(a, c);
+	g->addEdge(b, d);
+	g->addEdge(c, d);
+	g->lockEdgeWeights();
+
+	ProportionalPathBuilder builder(g, 0.01);
+	builder.setBudget(boost::make_shared<Budget>(1, 0));
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	// the heavier branch is followed first, then the budget runs out.
+	BOOST_REQUIRE_EQUAL(paths.size(), 1);
+	BOOST_REQUIRE(paths.find(path(a, b, d)) != paths.end());
+	BOOST_REQUIRE(builder.truncated());
+
+	// a budget that is never reached doesn't truncate the paths.
+	builder.setBudget(boost::make_shared<Budget>(10, 0));
+	g->resetEdgeWeights();
+	builder.setGraph(g);
+	BOOST_REQUIRE_EQUAL(builder.buildPaths().size(), 2);
+	BOOST_REQUIRE(!builder.truncated());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // PROPORTIONAL_PATH_BUILDER_TEST_CC
@@ -0,0 +1,89 @@
+/*
+ * File:   RandomPathBuilderTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef RANDOM_PATH_BUILDER_TEST_CC
+#define RANDOM_PATH_BUILDER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/foreach.hpp>
+
+#include "PathBuilder/Random/RandomPathBuilder.hh"
+#include "Util/Budget.hh"
+
+struct RandomPathBuilderFixture {
+	RandomPathBuilderFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+
+		// a -> b has weight 1, a -> c has weight 3.
+		g->addEdge(a, b);
+		g->addEdge(a, c, boost::make_shared<WeightedEdge>(3));
+		g->lockEdgeWeights();
+
+		ab.push_back(g->node(a));
+		ab.push_back(g->node(b));
+		ac.push_back(g->node(a));
+		ac.push_back(g->node(c));
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c;
+	PathBuilder::Path ab, ac;
+};
+
+BOOST_FIXTURE_TEST_SUITE (random_path_builder, RandomPathBuilderFixture)
+
+BOOST_AUTO_TEST_CASE (build_paths) {
+	RandomPathBuilder builder(g, 1000, 1, 42);
+	boost::unordered_set<PathBuilder::Path> paths = builder.buildPaths();
+
+	BOOST_REQUIRE_EQUAL(paths.size(), 2);
+	BOOST_REQUIRE(paths.find(ab) != paths.end());
+	BOOST_REQUIRE(paths.find(ac) != paths.end());
+
+	boost::unordered_map<PathBuilder::Path, std::size_t> frequencies = builder.getPathFrequencies();
+	BOOST_REQUIRE_EQUAL(frequencies[ab] + frequencies[ac], 1000);
+	// a -> c should be followed about three times as often as a -> b.
+	BOOST_REQUIRE(frequencies[ac] > 2 * frequencies[ab]);
+
+	// edge weights are never consumed.
+	BOOST_REQUIRE_EQUAL(g->edge(boost::edge(a, b, *g->graph()).first)->getWeight(), 1);
+}
+
+BOOST_AUTO_TEST_CASE (thread_count_is_deterministic) {
+	RandomPathBuilder single(g, 1001, 1, 7);
+	RandomPathBuilder multiple(g, 1001, 3, 7);
+	single.buildPaths();
+	multiple.buildPaths();
+
+	BOOST_REQUIRE(single.getPathFrequencies() == multiple.getPathFrequencies());
+}
+
+BOOST_AUTO_TEST_CASE (budget_keeps_most_frequent) {
+	RandomPathBuilder single(g, 1001, 1, 7);
+	RandomPathBuilder multiple(g, 1001, 3, 7);
+	single.setBudget(boost::make_shared<Budget>(1, 0));
+	multiple.setBudget(boost::make_shared<Budget>(1, 0));
+
+	boost::unordered_set<PathBuilder::Path> singlePaths = single.buildPaths();
+	boost::unordered_set<PathBuilder::Path> multiplePaths = multiple.buildPaths();
+
+	// a -> c is walked most often, no matter how the walks are split between threads.
+	BOOST_REQUIRE_EQUAL(singlePaths.size(), 1);
+	BOOST_REQUIRE(singlePaths.find(ac) != singlePaths.end());
+	BOOST_REQUIRE(singlePaths == multiplePaths);
+	BOOST_REQUIRE(single.getPathFrequencies() == multiple.getPathFrequencies());
+	BOOST_REQUIRE(single.truncated());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // RANDOM_PATH_BUILDER_TEST_CC
@@ -0,0 +1,120 @@
+/*
+ * File:   ReadBatchTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_BATCH_TEST_CC
+#define READ_BATCH_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include "Sequence/ReadBatch.hh"
+#include "Sequence/Sequence.hh"
+#include "Exception/InvalidInputException.hh"
+#include "Util/Util.hh"
+
+struct ReadBatchFixture {
+	ReadBatchFixture() : batch(3) {
+		batch.add("acgTTg", "first", "a comment", "");
+		batch.add("", "empty", "", "");
+		batch.add("GGCA", "third", "", "IIII");
+	}
+
+	ReadBatch batch;
+};
+
+BOOST_FIXTURE_TEST_SUITE (read_batch, ReadBatchFixture)
+
+BOOST_AUTO_TEST_CASE (views) {
+	batch.normalise();
+
+	BOOST_REQUIRE_EQUAL(batch.size(), 3);
+	BOOST_REQUIRE(!batch.empty());
+
+	BOOST_REQUIRE_EQUAL(batch.sequence(0), "ACGTTG");
+	BOOST_REQUIRE_EQUAL(batch.reverseComplement(0), "CAACGT");
+	BOOST_REQUIRE_EQUAL(batch.name(0), "first");
+	BOOST_REQUIRE_EQUAL(batch.comment(0), "a comment");
+	BOOST_REQUIRE(batch.qual(0).empty());
+
+	BOOST_REQUIRE(batch.sequence(1).empty());
+	BOOST_REQUIRE(batch.reverseComplement(1).empty());
+	BOOST_REQUIRE_EQUAL(batch.name(1), "empty");
+
+	BOOST_REQUIRE_EQUAL(batch.sequence(2), "GGCA");
+	BOOST_REQUIRE_EQUAL(batch.reverseComplement(2), "TGCC");
+	BOOST_REQUIRE_EQUAL(batch.qual(2), "IIII");
+}
+
+BOOST_AUTO_TEST_CASE (same_as_sequence) {
+	// the batch should describe a read exactly the way that Sequence does.
+	Sequence s("acgTTg", "first", "a comment", "");
+	batch.normalise();
+
+	BOOST_REQUIRE_EQUAL(batch.sequence(0), s.getSequence());
+	BOOST_REQUIRE_EQUAL(batch.reverseComplement(0), s.getReverseComplement());
+	BOOST_REQUIRE_EQUAL(batch.id(0), s.getID());
+	BOOST_REQUIRE_EQUAL(batch.id(2), qassembler::hash("third"));
+}
+
+BOOST_AUTO_TEST_CASE (source) {
+	ReadBatch other;
+	other.add("ACGT", "first", "", "");
+	other.setSource(1);
+	other.normalise();
+	batch.normalise();
+
+	BOOST_REQUIRE(other.id(0) != batch.id(0));
+	BOOST_REQUIRE_THROW(other.setSource(2), InvalidInputException);
+}
+
+BOOST_AUTO_TEST_CASE (segments) {
+	// before filtering, every record is one segment.
+	batch.normalise();
+	BOOST_REQUIRE_EQUAL(batch.segments(0), 1);
+	BOOST_REQUIRE_EQUAL(batch.segment(0, 0), "ACGTTG");
+	BOOST_REQUIRE_EQUAL(batch.segmentReverseComplement(0, 0), "CAACGT");
+
+	ReadBatch filtered;
+	filtered.add("ACGTTGCA", "quality", "", "55+55555");
+	filtered.normalise();
+	filtered.filter(ReadFilter(3, 20, 0));
+	BOOST_REQUIRE_EQUAL(filtered.segments(0), 1);
+	BOOST_REQUIRE_EQUAL(filtered.segment(0, 0), "TTGCA");
+	BOOST_REQUIRE_EQUAL(filtered.segmentReverseComplement(0, 0), "TGCAA");
+
+	// resolving ambiguous bases changes both strands.
+	ReadBatch ambiguous;
+	ambiguous.add("ACRTNGCA", "ambiguous", "", "");
+	ambiguous.normalise();
+	ambiguous.filter(ReadFilter(3, 0, 0, ReadFilter::RESOLVE_AMBIGUOUS));
+	BOOST_REQUIRE_EQUAL(ambiguous.sequence(0), "ACATNGCA");
+	BOOST_REQUIRE_EQUAL(ambiguous.reverseComplement(0), "TGCNATGT");
+	BOOST_REQUIRE_EQUAL(ambiguous.segments(0), 2);
+	BOOST_REQUIRE_EQUAL(ambiguous.segment(0, 0), "ACAT");
+	BOOST_REQUIRE_EQUAL(ambiguous.segmentReverseComplement(0, 0), "ATGT");
+	BOOST_REQUIRE_EQUAL(ambiguous.segment(0, 1), "GCA");
+	BOOST_REQUIRE_EQUAL(ambiguous.segmentReverseComplement(0, 1), "TGC");
+
+	ReadBatch unnormalised;
+	BOOST_REQUIRE_THROW(unnormalised.filter(ReadFilter(3, 20, 0)), InvalidInputException);
+}
+
+BOOST_AUTO_TEST_CASE (invalid_bases) {
+	ReadBatch invalid;
+	invalid.add("ACGU", "bad", "", "");
+	BOOST_REQUIRE_THROW(invalid.normalise(), InvalidInputException);
+}
+
+BOOST_AUTO_TEST_CASE (add_after_normalise) {
+	batch.normalise();
+	BOOST_REQUIRE_THROW(batch.add("ACGT", "late", "", ""), InvalidInputException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // READ_BATCH_TEST_CC
@@ -0,0 +1,125 @@
+/*
+ * File:   ReadCollapserTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_COLLAPSER_TEST_CC
+#define READ_COLLAPSER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+
+#include "Sequence/ReadCollapser.hh"
+#include "Graph/HeftyGraph.hh"
+
+#define KMER_LENGTH 3
+
+struct ReadCollapserFixture {
+	ReadCollapserFixture() {
+		batch.add("ACGTTG", "first", "", "");
+		batch.add("CAACGT", "reverse", "", "");
+		batch.add("GGCATT", "other", "", "");
+		batch.add("acgttg", "lower", "", "");
+		batch.normalise();
+	}
+
+	/**
+	 * Sum the counts of, and transitions from, every k-mer in a graph.
+	 * @param g the graph to sum
+	 * @return the total count and the total number of transitions.
+	 */
+	std::pair<std::size_t, std::size_t> weights(HeftyGraph &g) {
+		std::size_t counts = 0, transitions = 0;
+		BOOST_FOREACH (const HeftyGraph::Graphs::value_type &entry, g.getGraphs()) {
+			BOOST_FOREACH (SkinnyGraph::Vertex v, entry.second->getVertexIterators()) {
+				BOOST_FOREACH (boost::shared_ptr<Kmer> k, entry.second->node(v)->getKmers()) {
+					counts += k->getCount();
+					transitions += k->getTransitionCount('A') + k->getTransitionCount('C') +
+						k->getTransitionCount('G') + k->getTransitionCount('T');
+				}
+			}
+		}
+		return std::make_pair(counts, transitions);
+	}
+
+	ReadBatch batch;
+	ReadCollapser collapser;
+};
+
+BOOST_FIXTURE_TEST_SUITE (read_collapser, ReadCollapserFixture)
+
+BOOST_AUTO_TEST_CASE (collapse_batch) {
+	collapser.collapse(batch);
+
+	// the reverse complement and the lower-case copy are collapsed into the first read.
+	BOOST_REQUIRE_EQUAL(batch.copies(0), 3);
+	BOOST_REQUIRE_EQUAL(batch.copies(1), 0);
+	BOOST_REQUIRE_EQUAL(batch.copies(2), 1);
+	BOOST_REQUIRE_EQUAL(batch.copies(3), 0);
+	BOOST_REQUIRE(!batch.repeated(0));
+	BOOST_REQUIRE(!batch.repeated(2));
+
+	BOOST_REQUIRE_EQUAL(collapser.reads(), 4);
+	BOOST_REQUIRE_EQUAL(collapser.distinct(), 2);
+}
+
+BOOST_AUTO_TEST_CASE (collapse_across_batches) {
+	ReadBatch next;
+	next.add("AATGCC", "other-reverse", "", "");
+	next.add("TTTTTT", "new", "", "");
+	next.normalise();
+
+	collapser.collapse(batch);
+	collapser.collapse(next);
+
+	// a read from an earlier batch keeps its copy, but only adds weight.
+	BOOST_REQUIRE_EQUAL(next.copies(0), 1);
+	BOOST_REQUIRE(next.repeated(0));
+	BOOST_REQUIRE_EQUAL(next.copies(1), 1);
+	BOOST_REQUIRE(!next.repeated(1));
+
+	BOOST_REQUIRE_EQUAL(collapser.reads(), 6);
+	BOOST_REQUIRE_EQUAL(collapser.distinct(), 3);
+}
+
+BOOST_AUTO_TEST_CASE (collapse_segments) {
+	ReadBatch split;
+	// '5' is quality 20, '+' is quality 10, so the second read is split in two.
+	split.add("ACGTTG", "first", "", "555555");
+	split.add("ACGTTG", "second", "", "555+55");
+	split.normalise();
+	split.filter(ReadFilter(KMER_LENGTH, 20, 0));
+
+	collapser.collapse(split);
+
+	// the reads have the same bases but not the same segments.
+	BOOST_REQUIRE_EQUAL(split.copies(0), 1);
+	BOOST_REQUIRE_EQUAL(split.copies(1), 1);
+}
+
+BOOST_AUTO_TEST_CASE (collapsed_weights) {
+	HeftyGraph collapsed(KMER_LENGTH), expanded(KMER_LENGTH);
+	ReadBatch next;
+	next.add("ACGTTG", "again", "", "");
+	next.normalise();
+
+	expanded.addReadsToGraph(batch);
+	expanded.addReadsToGraph(next);
+
+	collapser.collapse(batch);
+	collapser.collapse(next);
+	BOOST_REQUIRE_EQUAL(collapsed.addReadsToGraph(batch), 4);
+	BOOST_REQUIRE_EQUAL(collapsed.addReadsToGraph(next), 1);
+
+	// the k-mers of the copies are counted as if every copy had been added.
+	BOOST_REQUIRE_EQUAL(collapsed.numGraphs(), expanded.numGraphs());
+	BOOST_REQUIRE(weights(collapsed) == weights(expanded));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // READ_COLLAPSER_TEST_CC
@@ -0,0 +1,167 @@
+/*
+ * File:   ReadFilterTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_FILTER_TEST_CC
+#define READ_FILTER_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <set>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "Sequence/ReadFilter.hh"
+#include "Sequence/ReadBatch.hh"
+
+#define KMER_LENGTH 3
+
+struct ReadFilterFixture {
+	ReadFilterFixture() : sequence("ACGTACGTAC") {}
+
+	/**
+	 * Split the read with some limits.
+	 * @param qual the qualities of the read
+	 * @param minBaseQuality the lowest quality of a base in an admitted k-mer
+	 * @param minKmerQuality the lowest mean quality of an admitted k-mer
+	 * @return the segments that the read was split into.
+	 */
+	std::vector<ReadSegment> split(std::string qual, std::size_t minBaseQuality, std::size_t minKmerQuality) {
+		std::vector<ReadSegment> segments;
+		ReadFilter(KMER_LENGTH, minBaseQuality, minKmerQuality).split(sequence, qual, segments);
+		return segments;
+	}
+
+	/**
+	 * Collect the k-mers of both strands of the segments of a read.
+	 * @param batch the (filtered) batch that the read is in
+	 * @param read the index of the read in the batch
+	 * @return the k-mers.
+	 */
+	std::set<std::string> kmers(const ReadBatch &batch, std::size_t read) {
+		std::set<std::string> found;
+		for (std::size_t s = 0; s < batch.segments(read); s++) {
+			boost::string_ref forward = batch.segment(read, s);
+			boost::string_ref reverse = batch.segmentReverseComplement(read, s);
+			for (std::size_t i = 0; i + KMER_LENGTH <= forward.size(); i++) {
+				found.insert(std::string(forward.substr(i, KMER_LENGTH)));
+				found.insert(std::string(reverse.substr(i, KMER_LENGTH)));
+			}
+		}
+		return found;
+	}
+
+	std::string sequence;
+};
+
+BOOST_FIXTURE_TEST_SUITE (read_filter, ReadFilterFixture)
+
+BOOST_AUTO_TEST_CASE (disabled) {
+	BOOST_REQUIRE(!ReadFilter(KMER_LENGTH, 0, 0).enabled());
+	BOOST_REQUIRE(ReadFilter(KMER_LENGTH, 20, 0).enabled());
+
+	std::vector<ReadSegment> segments = split("!!!!!!!!!!", 0, 0);
+	BOOST_REQUIRE_EQUAL(segments.size(), 1);
+	BOOST_REQUIRE_EQUAL(segments[0].start, 0);
+	BOOST_REQUIRE_EQUAL(segments[0].length, sequence.size());
+
+	// fasta reads have no qualities, so they're never split.
+	segments = split("", 20, 20);
+	BOOST_REQUIRE_EQUAL(segments.size(), 1);
+	BOOST_REQUIRE_EQUAL(segments[0].length, sequence.size());
+}
+
+BOOST_AUTO_TEST_CASE (min_base_quality) {
+	// '5' is quality 20, '+' is quality 10.
+	std::vector<ReadSegment> segments = split("5555+55555", 20, 0);
+	BOOST_REQUIRE_EQUAL(segments.size(), 2);
+	BOOST_REQUIRE_EQUAL(segments[0].start, 0);
+	BOOST_REQUIRE_EQUAL(segments[0].length, 4);
+	BOOST_REQUIRE_EQUAL(segments[1].start, 5);
+	BOOST_REQUIRE_EQUAL(segments[1].length, 5);
+
+	// a low-quality base near the end leaves a piece shorter than k, which is dropped.
+	segments = split("55555555+5", 20, 0);
+	BOOST_REQUIRE_EQUAL(segments.size(), 1);
+	BOOST_REQUIRE_EQUAL(segments[0].length, 8);
+
+	BOOST_REQUIRE(split("5+5+5+5+5+", 20, 0).empty());
+}
+
+BOOST_AUTO_TEST_CASE (min_kmer_quality) {
+	// windows are (20, 20, 10) = 16.7 on average around the '+', so only windows that don't
+	// include it have a mean of at least 20; windows with '?' (30) can make up for it.
+	std::vector<ReadSegment> segments = split("5555+55555", 0, 20);
+	BOOST_REQUIRE_EQUAL(segments.size(), 2);
+	BOOST_REQUIRE_EQUAL(segments[0].length, 4);
+	BOOST_REQUIRE_EQUAL(segments[1].start, 5);
+
+	segments = split("555?+?5555", 0, 20);
+	BOOST_REQUIRE_EQUAL(segments.size(), 1);
+	BOOST_REQUIRE_EQUAL(segments[0].length, sequence.size());
+
+	// both limits apply at once.
+	BOOST_REQUIRE_EQUAL(split("555?+?5555", 20, 20).size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE (ambiguous_bases) {
+	std::vector<ReadSegment> segments;
+	BOOST_REQUIRE(ReadFilter(KMER_LENGTH, 0, 0, ReadFilter::SPLIT_AMBIGUOUS).enabled());
+
+	// ambiguous bases are kept unless asked otherwise.
+	ReadFilter(KMER_LENGTH, 0, 0).split("ACGNACGTRA", "", segments);
+	BOOST_REQUIRE_EQUAL(segments.size(), 1);
+
+	// fasta reads are split too, and pieces shorter than k are dropped.
+	segments.clear();
+	ReadFilter(KMER_LENGTH, 0, 0, ReadFilter::SPLIT_AMBIGUOUS).split("ACGNACGTRA", "", segments);
+	BOOST_REQUIRE_EQUAL(segments.size(), 2);
+	BOOST_REQUIRE_EQUAL(segments[0].start, 0);
+	BOOST_REQUIRE_EQUAL(segments[0].length, 3);
+	BOOST_REQUIRE_EQUAL(segments[1].start, 4);
+	BOOST_REQUIRE_EQUAL(segments[1].length, 4);
+
+	// ambiguous bases and low qualities both split reads.
+	segments.clear();
+	ReadFilter(KMER_LENGTH, 20, 0, ReadFilter::SPLIT_AMBIGUOUS).split("ACGNACGTAC", "555555+555", segments);
+	BOOST_REQUIRE_EQUAL(segments.size(), 2);
+	BOOST_REQUIRE_EQUAL(segments[1].start, 7);
+	BOOST_REQUIRE_EQUAL(segments[1].length, 3);
+}
+
+BOOST_AUTO_TEST_CASE (resolve) {
+	BOOST_REQUIRE(ReadFilter(KMER_LENGTH, 0, 0, ReadFilter::RESOLVE_AMBIGUOUS).resolvesAmbiguity());
+	BOOST_REQUIRE(!ReadFilter(KMER_LENGTH, 0, 0, ReadFilter::SPLIT_AMBIGUOUS).resolvesAmbiguity());
+
+	// complementary codes resolve to complementary bases.
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('R'), 'A');
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('Y'), 'T');
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('K'), 'G');
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('M'), 'C');
+	// S and W are their own complements.
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('S'), 'S');
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('W'), 'W');
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('N'), 'N');
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('B'), 'B');
+	BOOST_REQUIRE_EQUAL(ReadFilter::resolve('T'), 'T');
+}
+
+BOOST_AUTO_TEST_CASE (resolve_both_strands) {
+	ReadBatch batch;
+	// the second read is the reverse complement of the first; the S splits both.
+	batch.add("ACRTGKCASGTAMCYA", "forward", "", "");
+	batch.add("TRGKTACSTGMCAYGT", "reverse", "", "");
+	batch.normalise();
+	batch.filter(ReadFilter(KMER_LENGTH, 0, 0, ReadFilter::RESOLVE_AMBIGUOUS));
+
+	BOOST_REQUIRE_EQUAL(batch.segments(0), 2);
+	BOOST_REQUIRE_EQUAL(batch.segments(1), 2);
+	BOOST_REQUIRE(kmers(batch, 0) == kmers(batch, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // READ_FILTER_TEST_CC
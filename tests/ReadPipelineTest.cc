@@ -0,0 +1,135 @@
+/*
+ * File:   ReadPipelineTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef READ_PIPELINE_TEST_CC
+#define READ_PIPELINE_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <fstream>
+#include <zlib.h>
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "IO/ReadPipeline.hh"
+#include "Util/Util.hh"
+
+#define READS 100
+
+struct ReadPipelineFixture {
+	ReadPipelineFixture() : filename(boost::filesystem::unique_path("read-pipeline-%%%%%%%%.fna").string()),
+			plain(filename) {
+		std::ofstream out(filename.c_str());
+		for (std::size_t i = 0; i < READS; i++) {
+			out << ">read" << i << std::endl << "acgtacgt" << std::string(i % 7, 'a') << std::endl;
+		}
+	}
+
+	~ReadPipelineFixture() {
+		boost::filesystem::remove(plain);
+		boost::filesystem::remove(plain + ".gz");
+	}
+
+	/**
+	 * Make a gzip-compressed copy of the file, so that it's read with zlib instead of being
+	 * mapped into memory.
+	 */
+	void compress() {
+		std::ifstream in(filename.c_str());
+		std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		in.close();
+
+		filename = plain + ".gz";
+		gzFile gz = gzopen(filename.c_str(), "w");
+		gzwrite(gz, contents.data(), contents.size());
+		gzclose(gz);
+	}
+
+	/**
+	 * Read the whole file, checking that the reads come out in the same order as the file.
+	 */
+	void readAll(std::size_t parserThreads, std::size_t batchSize, std::size_t queueDepth) {
+		readAll(std::vector<std::string>(1, filename), parserThreads, batchSize, queueDepth);
+	}
+
+	/**
+	 * Read several copies of the file, checking that the reads come out in the same order as
+	 * the files.
+	 * @return the identifiers of the reads.
+	 */
+	std::vector<std::size_t> readAll(std::vector<std::string> files, std::size_t parserThreads, std::size_t batchSize, std::size_t queueDepth) {
+		ReadPipeline pipeline(files, parserThreads, batchSize, queueDepth);
+		std::vector<std::size_t> ids;
+
+		while (boost::shared_ptr<ReadBatch> batch = pipeline.nextBatch()) {
+			BOOST_REQUIRE(!batch->empty());
+			BOOST_REQUIRE(batch->size() <= batchSize);
+			for (std::size_t i = 0; i < batch->size(); i++) {
+				std::size_t read = ids.size() % READS;
+				BOOST_REQUIRE_EQUAL(batch->name(i), "read" + boost::lexical_cast<std::string>(read));
+				BOOST_REQUIRE_EQUAL(batch->sequence(i), "ACGTACGT" + std::string(read % 7, 'A'));
+				ids.push_back(batch->id(i));
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(ids.size(), READS * files.size());
+		BOOST_REQUIRE(!pipeline.nextBatch());
+		BOOST_REQUIRE_EQUAL(pipeline.position(), pipeline.size());
+
+		return ids;
+	}
+
+	/** the file to read */
+	std::string filename;
+	/** the uncompressed file */
+	std::string plain;
+};
+
+BOOST_FIXTURE_TEST_SUITE (read_pipeline, ReadPipelineFixture)
+
+BOOST_AUTO_TEST_CASE (parse_in_reader) {
+	readAll(0, 8, 2);
+}
+
+BOOST_AUTO_TEST_CASE (parser_pool) {
+	readAll(1, 8, 2);
+	readAll(4, 3, 1);
+	readAll(4, 1000, 4);
+}
+
+BOOST_AUTO_TEST_CASE (compressed) {
+	compress();
+	readAll(0, 8, 2);
+	readAll(4, 3, 1);
+}
+
+BOOST_AUTO_TEST_CASE (several_files) {
+	std::vector<std::string> files(1, plain);
+	compress();
+	files.push_back(filename);
+	files.push_back(plain);
+
+	for (std::size_t parserThreads = 0; parserThreads <= 2; parserThreads += 2) {
+		std::vector<std::size_t> ids = readAll(files, parserThreads, 7, 2);
+		BOOST_REQUIRE_EQUAL(ids[0], qassembler::hash("read0"));
+		// the same read in different files gets a different identifier.
+		BOOST_REQUIRE(ids[0] != ids[READS]);
+		BOOST_REQUIRE(ids[0] != ids[2 * READS]);
+		BOOST_REQUIRE(ids[READS] != ids[2 * READS]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE (stop_early) {
+	// destroying a pipeline that hasn't been read to the end stops the background threads.
+	ReadPipeline pipeline(std::vector<std::string>(1, filename), 2, 1, 1);
+	BOOST_REQUIRE(pipeline.nextBatch());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // READ_PIPELINE_TEST_CC
@@ -0,0 +1,91 @@
+/*
+ * File:   StrongComponentsTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef STRONG_COMPONENTS_TEST_CC
+#define STRONG_COMPONENTS_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+
+#include "Graph/StrongComponents.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+struct StrongComponentsFixture {
+	StrongComponentsFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+		d = g->createSequenceNode(0x0045, 't', "read0004", 0x9004, 0, Kmer::FORWARD);
+
+		// a -> b -> c -> d, with b and c forming a cycle.
+		g->addEdge(a, b);
+		g->addEdge(b, c);
+		g->addEdge(c, b);
+		g->addEdge(c, d);
+	}
+
+	std::size_t componentOf(StrongComponents &sc, SkinnyGraph::Vertex v) {
+		return sc.component(sc.vertexIndex(v));
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c, d;
+};
+
+BOOST_FIXTURE_TEST_SUITE (strong_components, StrongComponentsFixture)
+
+BOOST_AUTO_TEST_CASE (components) {
+	StrongComponents sc(g);
+
+	BOOST_REQUIRE_EQUAL(sc.numVertices(), 4);
+	BOOST_REQUIRE_EQUAL(sc.numComponents(), 3);
+	BOOST_REQUIRE_EQUAL(componentOf(sc, b), componentOf(sc, c));
+	BOOST_REQUIRE(sc.vertex(sc.vertexIndex(d)) == d);
+
+	BOOST_REQUIRE(!sc.acyclic());
+	BOOST_REQUIRE_EQUAL(sc.numCyclicComponents(), 1);
+	BOOST_REQUIRE(sc.cyclic(componentOf(sc, b)));
+	BOOST_REQUIRE(!sc.cyclic(componentOf(sc, a)));
+	BOOST_REQUIRE(!sc.cyclic(componentOf(sc, d)));
+}
+
+BOOST_AUTO_TEST_CASE (condensed) {
+	StrongComponents sc(g);
+	std::size_t ca = componentOf(sc, a), cb = componentOf(sc, b), cd = componentOf(sc, d);
+
+	// components are numbered in reverse topological order.
+	BOOST_REQUIRE(ca > cb);
+	BOOST_REQUIRE(cb > cd);
+
+	BOOST_REQUIRE_EQUAL(sc.successors(ca).size(), 1);
+	BOOST_REQUIRE_EQUAL(sc.successors(ca)[0], cb);
+	BOOST_REQUIRE_EQUAL(sc.successors(cb).size(), 1);
+	BOOST_REQUIRE_EQUAL(sc.successors(cb)[0], cd);
+	BOOST_REQUIRE(sc.successors(cd).empty());
+}
+
+BOOST_AUTO_TEST_CASE (self_loop) {
+	g->addEdge(d, d);
+	StrongComponents sc(g);
+
+	BOOST_REQUIRE_EQUAL(sc.numCyclicComponents(), 2);
+	BOOST_REQUIRE(sc.cyclic(componentOf(sc, d)));
+}
+
+BOOST_AUTO_TEST_CASE (missing_vertex) {
+	StrongComponents sc(g);
+	SkinnyGraph other(2);
+	SkinnyGraph::Vertex v = other.createSequenceNode(0x0046, 'a', "read0005", 0x9005, 0, Kmer::FORWARD);
+
+	BOOST_REQUIRE_THROW(sc.vertexIndex(v), InvalidGraphStateException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // STRONG_COMPONENTS_TEST_CC
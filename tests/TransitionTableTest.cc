@@ -0,0 +1,67 @@
+/*
+ * File:   TransitionTableTest.cc
+ * Author: fbristow
+ *
+ * Created on October 18, 2026
+ */
+#ifndef TRANSITION_TABLE_TEST_CC
+#define TRANSITION_TABLE_TEST_CC
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <cmath>
+
+#include "Abundance/MarkovAbundance/TransitionTable.hh"
+#include "Exception/InvalidGraphStateException.hh"
+
+struct TransitionTableFixture {
+	TransitionTableFixture() : g(boost::make_shared<SkinnyGraph>(1)) {
+		a = g->createSequenceNode(0x0042, 'a', "read0001", 0x9001, 0, Kmer::FORWARD);
+		b = g->createSequenceNode(0x0043, 'c', "read0002", 0x9002, 0, Kmer::FORWARD);
+		c = g->createSequenceNode(0x0044, 'g', "read0003", 0x9003, 0, Kmer::FORWARD);
+
+		// a -> b has weight 1, a -> c has weight 3.
+		g->addEdge(a, b);
+		g->addEdge(a, c, boost::make_shared<WeightedEdge>(3));
+	}
+
+	boost::shared_ptr<SkinnyGraph> g;
+	SkinnyGraph::Vertex a, b, c;
+};
+
+BOOST_FIXTURE_TEST_SUITE (transition_table, TransitionTableFixture)
+
+BOOST_AUTO_TEST_CASE (constructor_test) {
+	TransitionTable table(g, 4);
+
+	BOOST_REQUIRE_EQUAL(table.numVertices(), 3);
+	BOOST_REQUIRE_EQUAL(table.numEdges(), 2);
+}
+
+BOOST_AUTO_TEST_CASE (transition_probabilities) {
+	TransitionTable table(g, 4);
+
+	BOOST_REQUIRE_CLOSE(table.logTransition(table.edgeIndex(a, b)), log(0.25), 1e-9);
+	BOOST_REQUIRE_CLOSE(table.logTransition(table.edgeIndex(a, c)), log(0.75), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE (begin_probabilities) {
+	TransitionTable table(g, 4);
+
+	// each vertex has a single k-mer that was seen once.
+	BOOST_REQUIRE_CLOSE(table.logBegin(table.vertexIndex(a)), log(0.25), 1e-9);
+	BOOST_REQUIRE_CLOSE(table.logBegin(table.vertexIndex(c)), log(0.25), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE (missing_edge) {
+	TransitionTable table(g, 4);
+
+	BOOST_REQUIRE_THROW(table.edgeIndex(b, c), InvalidGraphStateException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // TRANSITION_TABLE_TEST_CC